@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file BalanceHistory.hpp
+ * @brief 按账户的余额版本历史：查询任意时刻的余额 / История версий остатка по счетам: остаток на любой момент
+ *
+ * 每个账户一个只追加的版本列表（时间, 余额）。同一分钟内的多次变动合并为一个版本，
+ * 版本按 kBlock 个分块：块首是绝对值检查点，其余版本只存与前一版本的差
+ * （分钟差与余额差，变长整数编码，余额差先做 zigzag），通常每个版本 4-8 字节，
+ * 而不是 (时间, 余额) 原样存放的 16 字节。
+ * 查询先在检查点上二分，再在块内最多解码 kBlock - 1 个差值。
+ *
+ * У каждого счёта только дописываемый список версий (время, остаток). Несколько
+ * изменений в одну минуту сливаются в одну версию. Версии разбиты на блоки по kBlock:
+ * первая версия блока - контрольная точка с абсолютными значениями, остальные хранят
+ * только разницу с предыдущей (разницу минут и остатка, целые переменной длины, остаток
+ * через zigzag), обычно 4-8 байт на версию вместо 16 байт пары (время, остаток) как есть.
+ * Запрос - двоичный поиск по контрольным точкам и декодирование не более kBlock - 1
+ * разностей внутри блока.
+ */
+
+#include "DenseTable.hpp"
+#include "Domain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace bank {
+
+class BalanceHistory {
+public:
+    static constexpr std::uint32_t kBlock = 16;     ///< 每块版本数 / Версий в блоке
+
+    /**
+     * @brief 记录账户在 time 之后的余额 / Запись остатка счёта после момента time
+     *
+     * 时间早于该账户上一版本时按上一版本的时间记录（版本按重放顺序排列）。
+     * Время раньше предыдущей версии счёта заменяется временем этой версии (версии идут в порядке воспроизведения).
+     */
+    void record(unsigned long long accountId, const domain::DateTime& time, domain::Money balance);
+
+    /**
+     * @brief 账户在 time（含该分钟内的全部变动）时的余额 / Остаток счёта на момент time (с изменениями этой минуты)
+     *
+     * @return 账户未知或 time 早于第一个版本时为空 / Пусто, если счёт неизвестен или time раньше первой версии
+     */
+    std::optional<domain::Money> asOf(unsigned long long accountId, const domain::DateTime& time) const;
+
+    /// 全部账户的版本数 / Число версий всех счетов
+    std::size_t versions() const { return versions_; }
+
+    /// 版本数据占用的字节数（不含容器预留）/ Байт под данные версий (без резерва контейнеров)
+    std::size_t bytes() const;
+
+private:
+    struct Checkpoint {
+        std::uint32_t minute{};                 ///< 绝对分钟 / Абсолютная минута
+        std::uint32_t offset{};                 ///< 块内差值在 deltas 中的起点 / Начало разностей блока в deltas
+        std::int64_t balance{};                 ///< 余额（千分位）/ Остаток (в тысячных)
+    };
+
+    struct AccountHistory {
+        std::vector<Checkpoint> checkpoints;
+        std::vector<std::uint8_t> deltas;       ///< 变长编码的 (分钟差, 余额差) / Пары (разница минут, разница остатка) переменной длины
+        std::int64_t lastBalance{};
+        std::int64_t prevBalance{};             ///< 倒数第二个版本，用于同一分钟内改写 / Предпоследняя версия - для перезаписи в ту же минуту
+        std::uint32_t lastMinute{};
+        std::uint32_t prevMinute{};
+        std::uint32_t count{};                  ///< 版本数 / Число версий
+        std::uint32_t lastOffset{};             ///< 最后一个差值的起点 / Начало последней разности
+    };
+
+    /// 自第 0 天起的分钟数（32 位足够约 290 万天）/ Минуты от дня 0 (32 бит хватает примерно на 2,9 млн дней)
+    static std::uint32_t toMinute(const domain::DateTime& time) {
+        return static_cast<std::uint32_t>((time.day * 24 + time.hour) * 60 + time.minute);
+    }
+    static void putDelta(std::vector<std::uint8_t>& out, std::uint32_t minutes, std::int64_t balance);
+
+    DenseTable<AccountHistory> accounts_;
+    std::size_t versions_{0};
+};
+
+}  // namespace bank
@@ -12,15 +12,31 @@
  * работы банка, обработке событий и выводу результатов.
  */
 
+#include "BalanceHistory.hpp"
+#include "ColumnarExport.hpp"
+#include "DenseTable.hpp"
 #include "Domain.hpp"
+#include "Input.hpp"
+#include "InterestEngine.hpp"
+#include "Journal.hpp"
+#include "Ledger.hpp"
+#include "NameIndex.hpp"
+#include "Output.hpp"
+#include "Profiler.hpp"
+#include "RuleEngine.hpp"
+#include "Scheduler.hpp"
 
 #include <array>
-#include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <set>
 
 namespace bank {
 
+class QueryService;
+class ThreadPool;
+
 /**
  * @brief 银行系统主类 / Основной класс банковской системы
  * 
@@ -40,6 +56,29 @@ namespace bank {
  */
 class BankSystem {
 public:
+    /**
+     * @brief 单个营业日的统计 / Статистика одного банковского дня
+     * 
+     * 多分行驱动据此汇总各分行的日报。
+     * По ней многофилиальный драйвер сводит дневные отчёты отделений.
+     */
+    struct DayStats {
+        unsigned long long day{};           ///< 营业日 / Банковский день
+        unsigned long long appeals{};       ///< 客户来访数 / Число обращений
+        unsigned long long operations{};    ///< 操作数 / Число операций
+        unsigned long long transfers{};     ///< 转账日志条数 / Число записей журнала переводов
+        std::array<domain::Money, domain::kCurrencyCount> fees{};  ///< 按币种的手续费收入 / Комиссии по валютам
+        unsigned long long customers{};     ///< 排队的客户 / Клиентов в очередях
+        unsigned long long turnedAway{};    ///< 营业结束未办完 / Не обслуженных до закрытия
+        std::vector<unsigned long long> waitHistogram;  ///< 等待分钟直方图 / Гистограмма ожидания в минутах
+    };
+
+    /// 推测执行的统计 / Статистика спекулятивного выполнения
+    struct SpeculationStats {
+        unsigned long long appeals{};       ///< 推测执行的来访 / Обращений, выполненных спекулятивно
+        unsigned long long reexecuted{};    ///< 因冲突在提交时重新执行 / Выполнены повторно при фиксации из-за конфликта
+    };
+
     /**
      * @brief 构造函数 / Конструктор
      * 
@@ -48,6 +87,22 @@ public:
      */
     BankSystem();
 
+    /**
+     * @brief 指定输出文件的构造函数 / Конструктор с указанием файлов вывода
+     * 
+     * @param out 业务响应输出（默认 stdout）/ Вывод ответов (по умолчанию stdout)
+     * @param log 交易日志输出（默认 stderr）/ Вывод журнала транзакций (по умолчанию stderr)
+     */
+    BankSystem(std::FILE* out, std::FILE* log);
+
+    /**
+     * @brief 析构函数：刷新剩余输出 / Деструктор: сброс оставшегося вывода
+     */
+    ~BankSystem();
+
+    BankSystem(const BankSystem&) = delete;
+    BankSystem& operator=(const BankSystem&) = delete;
+
     /**
      * @brief 加载初始数据 / Загрузка начальных данных
      * 
@@ -56,29 +111,344 @@ public:
      * Client Credit, Work Places, Exchange Rates
      * 
      * Читает все начальные таблицы данных в порядке, требуемом задачей:
+     * 
+     * 输入文件整体映射到内存，先定位各表边界，再并行解析各表。
+     * Входной файл целиком отображается в память, сначала находятся границы
+     * таблиц, затем таблицы разбираются параллельно.
+     * 
+     * @param inputPath 输入文件路径，nullptr 表示标准输入 / Путь к входному файлу, nullptr - stdin
+     * @return 是否成功；失败原因已写入 stderr / Успешно ли; причина ошибки уже выведена в stderr
      */
-    void loadInitialData();
+    bool loadInitialData(const char* inputPath = nullptr);
 
     /**
      * @brief 运行事件循环 / Запуск цикла обработки событий
      * 
-     * 从标准输入读取事件并逐一处理，直到输入结束。
-     * Читает события из стандартного ввода и обрабатывает их по одному до конца ввода.
+     * 从初始数据之后的输入缓冲读取事件并逐一处理，直到输入结束。
+     * Читает события из буфера ввода после начальных данных и обрабатывает их по одному до конца ввода.
+     * 
+     * @return false 表示银行违约而提前停止 / false - остановка из-за дефолта банка
+     */
+    bool run();
+
+    /**
+     * @brief 启用预写日志与定期快照 / Включение журнала предзаписи и периодических снимков
+     * 
+     * 在 loadInitialData 之后、run 之前调用。目录中已有快照或日志时先恢复状态
+     * （快照 + 已提交的日志尾部），并把事件流定位到最后一个已提交营业日之后，
+     * 之前的事件不再重放。
+     * 
+     * Вызывается после loadInitialData и до run. Если в каталоге уже есть снимок или
+     * журнал, состояние восстанавливается (снимок + зафиксированный хвост журнала),
+     * а поток событий продолжается после последнего зафиксированного дня без
+     * повторной обработки предыдущих событий.
+     * 
+     * @param directory 日志与快照目录 / Каталог журнала и снимков
+     * @param snapshotEveryDays 每隔多少个营业日写一次快照 / Через сколько банковских дней писать снимок
+     * @return 是否成功；失败原因已写入 stderr / Успешно ли; причина ошибки уже в stderr
      */
-    void run();
+    bool enableJournal(const std::string& directory, unsigned long long snapshotEveryDays);
+
+    /**
+     * @brief 把已过账的分录写入二进制账簿 / Запись проведённых проводок в двоичную книгу
+     * 
+     * 每笔 30 字节（营业日、时间、借方、贷方、金额），营业日结束时追加到 path。
+     * По 30 байт на проводку (день, время, дебет, кредит, сумма), дописываются в path в конце дня.
+     */
+    bool enableLedger(const std::string& path);
+
+    /**
+     * @brief 营业日结束时把账户表列式导出 / Колоночная выгрузка таблицы счетов в конце банковского дня
+     * 
+     * 每天追加一个行组：账号、所有者（无主为 0）、余额（千分位）、币种与类型（字典编码）、
+     * 是否活动，以及当天的转入、转出总额与过账笔数。格式见 ColumnarExport.hpp。
+     * Каждый день дописывается группа строк: номер, владелец (0 - без владельца), остаток
+     * (в тысячных), валюта и тип (словарь), активность, а также суммы зачислений и списаний
+     * за день и число проводок. Формат см. в ColumnarExport.hpp.
+     */
+    bool enableColumnarExport(const std::string& path);
+
+    /**
+     * @brief 是否并行解析初始数据（默认开启）/ Параллельный ли разбор начальных данных (по умолчанию да)
+     * 
+     * 多分行驱动中各分行已在线程池上并行，关闭它以免线程过量。
+     * В многофилиальном драйвере отделения уже выполняются параллельно, отключение избегает лишних потоков.
+     */
+    void setParallelLoad(bool enabled) { parallelLoad_ = enabled; }
+
+    /**
+     * @brief 在多个线程上推测执行 Personal Appeal / Спекулятивное выполнение Personal Appeal на нескольких потоках
+     * 
+     * shards > 1 时，来访积压到下一个其他类型的事件（营业日开始/结束等），按窗口处理：
+     * 窗口内的来访由 shards 个线程按窗口开始时的状态并行执行（不写共享状态，只记录结果与读集），
+     * 再在写线程上按原始顺序提交。读集中的账户（或本客户的账户数）已被窗口内更早的提交修改时，
+     * 推测作废，该来访在提交位置按顺序模式重新执行；输出与顺序模式逐字节一致。
+     * 
+     * При shards > 1 обращения копятся до следующего события другого типа (начало/конец
+     * дня и т.п.) и обрабатываются окнами: обращения окна выполняются на shards потоках
+     * по состоянию на начало окна (общее состояние не пишется, запоминаются результаты и
+     * множество чтения), затем фиксируются потоком записи в исходном порядке. Если счёт из
+     * множества чтения (или число счетов клиента) изменён более ранней фиксацией в этом окне,
+     * спекуляция отбрасывается и обращение заново выполняется на своём месте последовательно;
+     * вывод побайтно совпадает с последовательным режимом.
+     * 
+     * @param shards 线程数，0 或 1 表示顺序执行 / Число потоков, 0 или 1 - последовательно
+     */
+    void setAppealShards(std::size_t shards);
+
+    /// 推测窗口的来访数（默认 256，0 表示整个批次）/ Обращений в окне спекуляции (по умолчанию 256, 0 - весь пакет)
+    void setSpeculationWindow(std::size_t appeals) { speculationWindow_ = appeals; }
+
+    /// 推测执行的累计统计 / Накопленная статистика спекулятивного выполнения
+    const SpeculationStats& speculationStats() const { return speculationStats_; }
+
+    /**
+     * @brief 在重放的同时向查询服务发布快照 / Публикация снимков в сервис запросов во время воспроизведения
+     * 
+     * run 在事件之间按服务的发布间隔、在每个营业日结束时以及输入结束时复制账户表并发布。
+     * run между событиями с интервалом сервиса, в конце каждого дня и в конце ввода
+     * копирует таблицу счетов и публикует её.
+     * 
+     * @param service 查询服务，nullptr 表示不发布 / Сервис запросов, nullptr - без публикации
+     */
+    void attachQueryService(QueryService* service) { queryService_ = service; }
+
+    /**
+     * @brief 记录各账户的余额版本，以便查询任意时刻的余额 / Версии остатков счетов для запроса остатка на любой момент
+     * 
+     * 开启时记下全部账户的当前余额，之后每次过账按事件时间记录新版本。从预写日志恢复的
+     * 变动没有时间，恢复之前的余额不在历史中，因此应在 enableJournal 之后调用。
+     * 输入结束时发布的最后一个快照带有历史，查询服务据此回答 "Balance As Of"。
+     * При включении запоминаются текущие остатки всех счетов, далее каждая проводка
+     * добавляет версию со временем события. Изменения, восстановленные из журнала, времени
+     * не имеют и в историю не попадают, поэтому вызывать после enableJournal.
+     * Последний снимок, публикуемый в конце ввода, содержит историю: по ней сервис
+     * запросов отвечает на "Balance As Of".
+     */
+    void enableBalanceHistory();
+
+    /// 账户在 time 时的余额；未开启历史或没有版本时为空 / Остаток счёта на момент time; пусто без истории или версий
+    std::optional<domain::Money> balanceAsOf(unsigned long long accountId, const domain::DateTime& time) const;
+
+    /**
+     * @brief 在过账流上检查风控规则 / Проверка правил контроля мошенничества на потоке проводок
+     * 
+     * 规则格式见 RuleEngine.hpp。每笔过账算作借方账户所有者发起（现金存入算作贷方账户所有者，
+     * 银行内部账户之间的过账不检查），开户按提交顺序检查。触发时向 alerts 写一行
+     * "<日> # <时>:<分> # Alert # <规则序号> # <规则名> # <客户> # <账户> # <金额>"，与业务响应一同刷新。
+     * Формат правил см. в RuleEngine.hpp. Проводку инициирует владелец счёта дебета (при
+     * внесении наличных - владелец счёта кредита, проводки между внутренними счетами банка
+     * не проверяются); открытия счетов проверяются в порядке фиксации. При срабатывании в
+     * alerts пишется строка "<день> # <ч>:<м> # Alert # <номер правила> # <имя> # <клиент> #
+     * <счёт> # <сумма>", сбрасывается вместе с ответами.
+     * 
+     * @param rulesPath 规则文件 / Файл правил
+     * @param alerts 告警输出，调用方负责关闭 / Вывод срабатываний; закрывает вызывающий
+     * @return 是否成功；失败原因已写入 stderr / Успешно ли; причина ошибки уже в stderr
+     */
+    bool enableRules(const std::string& rulesPath, std::FILE* alerts);
+
+    /**
+     * @brief 营业日结束时把各操作的延迟统计写入 report / Запись статистики задержек операций в report в конце дня
+     * 
+     * 只在 -DBANK_PROFILE=ON 构建中有数据；统计每次运行都不同，所以不写入交易日志。
+     * Данные есть только в сборке с -DBANK_PROFILE=ON; статистика меняется от запуска к
+     * запуску, поэтому в журнал транзакций не пишется.
+     * 
+     * @param report 输出文件，调用方负责关闭 / Файл вывода; закрывает вызывающий
+     */
+    void enableProfileReport(std::FILE* report);
+
+    /// 已结束营业日的统计 / Статистика завершённых банковских дней
+    const std::vector<DayStats>& dailyStats() const { return dailyStats_; }
 
 private:
-    // ==================== 类型别名 / Псевдонимы типов ====================
-    using AccountMap = std::unordered_map<unsigned long long, domain::Account>;
-    using ClientMap = std::unordered_map<unsigned long long, domain::Client>;
-    using DepositMap = std::unordered_map<unsigned long long, domain::Deposit>;
-    using LoanMap = std::unordered_map<unsigned long long, domain::Loan>;
+    // ==================== 存储行 / Строки хранилища ====================
+    /// 账户关联的产品 / Продукт, к которому привязан счёт
+    enum class Product : std::uint8_t {
+        None,       ///< 普通账户 / Обычный счёт
+        Deposit,    ///< 存款账户 / Счёт депозита
+        Loan,       ///< 贷款账户 / Счёт кредита
+    };
+
+    /**
+     * @brief 账户行 / Строка счёта
+     * 
+     * 所有者与账户记录存放在同一行中，一次下标访问即可完成
+     * 查找、权限校验与按币种计数，不再需要额外的哈希查找。
+     * 
+     * Владелец хранится в одной строке со счётом: поиск, проверка прав
+     * и подсчёт по валютам выполняются одним обращением по индексу.
+     */
+    struct AccountRow {
+        domain::Account account;        ///< 账户记录 / Запись счёта
+        unsigned long long owner{};     ///< 所有者客户ID / ID клиента-владельца
+        bool hasOwner{false};           ///< 是否有所有者 / Есть ли владелец
+        domain::Money dayMin{};         ///< minDay 当天的最低余额 / Минимальный остаток за день minDay
+        unsigned long long minDay{};    ///< dayMin 所属的营业日 / День, к которому относится dayMin
+        std::uint32_t slot{};           ///< 在所有者活跃账户索引中的位置 / Позиция в индексе активных счетов владельца
+        Product product{Product::None}; ///< 关联的存款/贷款，不能手动销户 / Депозит/кредит; закрыть вручную нельзя
+        unsigned long long maturesOn{}; ///< 存款到期日（0 - 活期）/ День окончания депозита (0 - до востребования)
+        domain::Money loanAmount{};     ///< 贷款金额：还款后余额的上限 / Сумма кредита: предел остатка при погашении
+        std::uint32_t window{};         ///< 最后一次提交修改所在的推测窗口 / Окно спекуляции последнего изменения при фиксации
+        std::uint32_t postingMark{};    ///< 过账校验的批次标记 / Метка пакета при проверке проводок
+        domain::Money postingBalance{}; ///< 过账校验中的滚动余额 / Текущий остаток при проверке проводок
+        domain::Money dayIn{};          ///< minDay 当天转入总额 / Зачислено за день minDay
+        domain::Money dayOut{};         ///< minDay 当天转出总额 / Списано за день minDay
+        std::uint32_t dayPostings{};    ///< minDay 当天过账笔数 / Проводок за день minDay
+    };
+
+    /**
+     * @brief 客户行 / Строка клиента
+     * 
+     * activeAccounts: 按币种分组的活跃账户号，[0]=RUB, [1]=YUAN, [2]=USD, [3]=EUR；
+     * 账户行的 slot 记录其在列表中的位置，增删都是 O(1)（删除时与末尾交换）。
+     * 
+     * activeAccounts: номера активных счетов по валютам, [0]=RUB, [1]=YUAN, [2]=USD, [3]=EUR;
+     * slot в строке счёта хранит позицию в списке, добавление и удаление - O(1)
+     * (удаление - обменом с последним).
+     */
+    struct ClientRow {
+        using AccountList = std::pmr::vector<unsigned long long>;
+
+        ClientRow() = default;
+
+        /// 活跃账户列表从 pool 分配 / Списки активных счетов выделяются из pool
+        explicit ClientRow(std::pmr::memory_resource* pool)
+            : activeAccounts{AccountList(pool), AccountList(pool), AccountList(pool), AccountList(pool)} {
+            static_assert(domain::kCurrencyCount == 4);
+        }
+
+        domain::Client client;                                  ///< 客户记录 / Запись клиента
+        std::array<AccountList, domain::kCurrencyCount> activeAccounts{}; ///< 按币种的活跃账户 / Активные счета по валютам
+        std::uint32_t window{};                                 ///< 账户数最后一次变化所在的推测窗口 / Окно спекуляции последнего изменения числа счетов
+    };
+
+    // ==================== 来访执行 / Выполнение обращений ====================
+    /**
+     * @brief 一次 Personal Appeal / Одно обращение Personal Appeal
+     */
+    struct AppealRequest {
+        unsigned long long day{};
+        unsigned long long hour{};
+        unsigned long long minute{};
+        std::array<char, domain::kMaxString> name{};                ///< 客户姓名（就地解析，不分配）/ Имя клиента (разбирается на месте, без выделений)
+        domain::CustomerKind token{domain::CustomerKind::NotClient}; ///< 新客户的类型标识 / Тип для нового клиента
+        std::string_view operations;                                ///< 操作行所在的输入片段（不拷贝）/ Фрагмент ввода со строками операций (без копии)
+        std::size_t operationCount{};                               ///< 操作数 / Число операций
+        bool opensAccount{false};                                   ///< 含开户或申请借记卡 / Есть открытие счёта или дебетовая карта
+        const char* error{nullptr};                                 ///< 读取错误（写入日志）/ Ошибка чтения (в журнал)
+
+        std::string_view clientName() const { return name.data(); }
+    };
+
+    /// 客户识别结果 / Результат идентификации клиента
+    struct Admission {
+        bool admitted{false};                                       ///< 是否受理 / Принято ли обращение
+        bool registered{false};                                     ///< 本次新注册 / Зарегистрирован сейчас
+        unsigned long long clientId{};                              ///< 客户ID / ID клиента
+        domain::CustomerKind kind{domain::CustomerKind::NotClient}; ///< 客户类型 / Тип клиента
+    };
+
+    /**
+     * @brief 单个操作的执行结果 / Результат одной операции
+     * 
+     * 执行阶段只读共享状态并写入本客户的数据，结果在提交阶段按原始顺序转成输出。
+     * На этапе выполнения общее состояние только читается, а пишутся лишь данные своего
+     * клиента; на этапе фиксации результаты в исходном порядке превращаются в вывод.
+     */
+    struct OpResult {
+        enum class Kind : std::uint8_t {
+            LogError,           ///< 写入日志 / Запись в журнал
+            Message,            ///< 固定文本响应 / Фиксированный ответ
+            Balance,            ///< 余额 / Баланс
+            PendingBalance,     ///< 提交时再查余额 / Баланс проверяется при фиксации
+            Created,            ///< 开户成功 / Счёт открыт
+            Exchanged,          ///< 提交时检查内部账户后兑换 / Обмен после проверки внутреннего счёта при фиксации
+            Closed,             ///< 销户：提交时扣款并输出 / Счёт закрыт: списание и вывод при фиксации
+            PendingClose,       ///< 今天新开的账户，提交时再销户 / Открытый сегодня счёт закрывается при фиксации
+            Posted,             ///< 充值/取款：提交时过账 / Пополнение/снятие: проводка при фиксации
+            PendingPosting,     ///< 今天新开的账户，提交时再校验并过账 / Открытый сегодня счёт: проверка и проводка при фиксации
+            Defaulted           ///< 银行违约 / Дефолт банка
+        };
+        Kind kind{Kind::Message};
+        const char* message{nullptr};                       ///< LogError/Message
+        unsigned long long accountId{};                     ///< Balance/PendingBalance/Closed/PendingClose
+        domain::Money amount{};                             ///< Balance：余额；Created：手续费；Exchanged：购入金额；Closed：付出的现金 / Balance: баланс; Created: комиссия; Exchanged: покупка; Closed: выдано наличными
+        domain::Money fee{};                                ///< Closed/Posted：手续费 / Closed/Posted: комиссия
+        domain::Operation operation{domain::Operation::Unknown}; ///< Posted/PendingPosting：充值或取款 / Пополнение или снятие
+        domain::Currency currency{domain::Currency::Unknown}; ///< Created/Exchanged
+        domain::Money soldAmount{};                         ///< Exchanged：客户付出的现金 / Exchanged: наличные клиента
+        domain::Currency soldCurrency{domain::Currency::Unknown}; ///< Exchanged
+#if BANK_PROFILE
+        std::uint64_t nanos{};                              ///< 执行阶段耗时 / Время фазы выполнения
+#endif
+    };
+
+    /**
+     * @brief 一次来访在执行阶段的私有效果与读集 / Частные эффекты и множество чтения обращения на этапе выполнения
+     * 
+     * 执行阶段不写共享状态：前面的操作对本客户账户余额、活跃状态与账户数的影响记在这里，
+     * 同一来访后面的操作据此校验。accounts 中的账户与 readsClient 构成读集，
+     * 提交前与各行的 window 标记比较，判断推测是否仍然有效。
+     * 
+     * На этапе выполнения общее состояние не пишется: влияние предыдущих операций на остатки,
+     * активность и число счетов клиента хранится здесь, и по нему проверяются следующие
+     * операции того же обращения. Счета в accounts и readsClient образуют множество чтения;
+     * перед фиксацией оно сравнивается с метками window строк, чтобы понять, верна ли ещё спекуляция.
+     */
+    struct AppealEffects {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        /// 本来访读过的一个本客户账户 / Прочитанный обращением счёт клиента
+        struct AccountEffect {
+            unsigned long long accountId{};
+            domain::Money delta{};          ///< 已批准、尚未过账的变动 / Одобренные, ещё не проведённые изменения
+            bool closed{false};             ///< 已批准销户 / Одобрено закрытие
+        };
+
+        AppealEffects() = default;
+        explicit AppealEffects(const allocator_type& allocator) : accounts(allocator) {}
+
+        std::pmr::vector<AccountEffect> accounts;                       ///< 读集 / Множество чтения
+        std::array<std::uint32_t, domain::kCurrencyCount> opened{};     ///< 已批准的开户 / Одобренные открытия
+        std::array<std::uint32_t, domain::kCurrencyCount> closed{};     ///< 已批准的销户 / Одобренные закрытия
+        bool readsClient{false};    ///< 读了本客户的账户数 / Прочитано число счетов клиента
+        bool ordered{false};        ///< 依赖提交时才确定的销户，只能按顺序执行 / Зависит от закрытия, известного лишь при фиксации
+
+        /// 登记读取并返回账户的效果 / Регистрация чтения и эффект счёта
+        AccountEffect& touch(unsigned long long accountId) {
+            for (auto& effect : accounts) {
+                if (effect.accountId == accountId) return effect;
+            }
+            return accounts.emplace_back(AccountEffect{accountId});
+        }
+
+        void clear() {
+            accounts.clear();
+            opened = {};
+            closed = {};
+            readsClient = false;
+            ordered = false;
+        }
+    };
 
     // ==================== 核心数据存储 / Основное хранилище данных ====================
-    AccountMap accounts_;          //所有账户的映射（账号 -> 账户信息）/ Карта всех счетов (номер -> информация)
-    ClientMap clients_;            //所有客户的映射（客户ID -> 客户信息）/ Карта всех клиентов (ID -> информация)
-    DepositMap deposits_;         //所有存款的映射（存款ID -> 存款信息）/ Карта всех депозитов (ID -> информация)
-    LoanMap loans_;               //所有贷款的映射（贷款ID -> 贷款信息）/ Карта всех кредитов (ID -> информация)
+    /**
+     * @brief 长期数据的块池 / Пул блоков для долгоживущих данных
+     * 
+     * 客户账户关联映射的节点与列表、客户的活跃账户列表都从这里分配；
+     * 声明在使用它的容器之前，因此最后析构。
+     * Отсюда выделяются узлы и списки карты связей и списки активных счетов клиентов;
+     * объявлен раньше использующих его контейнеров, поэтому разрушается последним.
+     */
+    std::pmr::unsynchronized_pool_resource nodePool_;
+
+    // 编号连续分配，按编号直接索引 / Номера выдаются подряд, индексация напрямую по номеру
+    DenseTable<AccountRow> accounts_;           ///< 账号 -> 账户行 / Номер -> строка счёта
+    DenseTable<ClientRow> clients_;             ///< 客户ID -> 客户行 / ID -> строка клиента
+    DenseTable<domain::Deposit> deposits_;      ///< 存款ID -> 存款 / ID -> депозит
+    DenseTable<domain::Loan> loans_;            ///< 贷款ID -> 贷款 / ID -> кредит
 
     // ==================== 关联关系数据 / Данные связей ====================
     /**
@@ -89,20 +459,25 @@ private:
      * 
      * Сохраняет связи между клиентами и счетами/депозитами/кредитами.
      * Ключ: ID клиента, значение: список всех связей счетов/депозитов/кредитов клиента.
+     * 
+     * 节点与各客户的列表都取自 nodePool_，开户时不再逐个向系统堆申请。
+     * Узлы и списки клиентов берутся из nodePool_, открытие счёта не обращается
+     * к системной куче за каждым узлом.
      */
-    std::unordered_map<unsigned long long, std::vector<domain::ClientAccount>> clientAccounts_;
+    using ClientAccountMap = std::pmr::unordered_map<unsigned long long, std::pmr::vector<domain::ClientAccount>>;
+    ClientAccountMap clientAccounts_{&nodePool_};
 
     /**
      * @brief 银行内部账户映射 / Карта внутренних банковских счетов
      * 
-     * 币种 -> 银行内部账户编号。
+     * 币种下标 -> 银行内部账户编号（该币种没有内部账户时为空）。
      * 每个币种对应一个银行内部账户，用于存储手续费、利息等银行资金。
      * 
-     * Валюта -> номер внутреннего банковского счёта.
+     * Индекс валюты -> номер внутреннего банковского счёта (пусто, если счёта нет).
      * Каждой валюте соответствует один внутренний банковский счёт для хранения
      * комиссий, процентов и других банковских средств.
      */
-    std::unordered_map<std::string, unsigned long long> bankInternalAccounts_;
+    std::array<std::optional<unsigned long long>, domain::kCurrencyCount> bankInternalAccounts_{};
 
     /**
      * @brief 工作岗位定义列表 / Список определений рабочих мест
@@ -113,46 +488,60 @@ private:
     std::vector<domain::WorkplaceDefinition> workplaces_;
 
     /**
-     * @brief 汇率映射 / Карта курсов обмена валют
+     * @brief 工作岗位排队模拟 / Модель очередей к рабочим местам
      * 
-     * 键：(出售货币, 购买货币)，值：兑换系数。
-     * Ключ: (продаваемая валюта, покупаемая валюта), значение: коэффициент обмена.
+     * 来访按提交顺序登记，营业日结束时推进并输出各岗位服务人数。
+     * Обращения регистрируются в порядке фиксации; в конце дня модель прогоняется
+     * и выводится число обслуженных по местам.
      */
-    std::map<std::pair<std::string, std::string>, double> exchangeRates_;
+    WorkplaceScheduler scheduler_;
 
-    // ==================== 派生状态数据 / Производные данные состояния ====================
-    /**
-     * @brief 账户所有者映射 / Карта владельцев счетов
-     * 
-     * 快速判断一个账户属于哪个客户，便于权限校验。
-     * 键：账户ID，值：客户ID。
-     * 
-     * Быстрая проверка, какому клиенту принадлежит счёт, для проверки прав доступа.
-     * Ключ: ID счёта, значение: ID клиента.
-     */
-    std::unordered_map<unsigned long long, unsigned long long> accountOwners_;
+    /// 输入文件中的汇率报价 / Котировки из входного файла
+    std::vector<domain::ExchangeRate> exchangeRates_;
 
     /**
-     * @brief 客户姓名到ID的映射 / Карта имени клиента к ID
+     * @brief 汇率矩阵（含交叉汇率）/ Матрица курсов (с кросс-курсами)
      * 
-     * 支持按照"姓 名 父名"直接定位客户记录。
-     * 键：客户姓名（字符串），值：客户ID。
-     * 
-     * Поддержка прямой локализации записи клиента по "фамилия имя отчество".
-     * Ключ: имя клиента (строка), значение: ID клиента.
+     * 在 buildDerivedState 中一次构建，兑换时按币种下标直接取值。
+     * Строится один раз в buildDerivedState; при обмене - прямой доступ по индексам валют.
      */
-    std::unordered_map<std::string, unsigned long long> clientNameToId_;
+    domain::RateMatrix rates_{};
+
+    /// 存款与贷款的计息账本 / Книги начисления процентов по депозитам и кредитам
+    InterestEngine interest_;
+
+    // ==================== 持久化 / Персистентность ====================
+    Ledger ledger_;                             ///< 过账批次与二进制账簿 / Пакет проводок и двоичная книга
+    std::uint32_t postingEpoch_{0};             ///< 过账校验的批次计数 / Счётчик пакетов проверки проводок
+    std::vector<std::array<AccountRow*, 2>> postingRows_; ///< 批次各分录的借方/贷方行 / Строки дебета/кредита проводок пакета
+    ColumnarWriter columnar_;                   ///< 营业日结束的列式导出 / Колоночная выгрузка в конце дня
+    Journal journal_;                           ///< 预写日志 / Журнал предзаписи
+    std::string journalDir_;                    ///< 日志与快照目录 / Каталог журнала и снимков
+    unsigned long long snapshotEveryDays_{0};   ///< 快照间隔（营业日）/ Интервал снимков (дни)
+    unsigned long long daysSinceSnapshot_{0};   ///< 上次快照后的营业日数 / Дней после последнего снимка
+
+    QueryService* queryService_{nullptr};       ///< 只读查询服务 / Сервис запросов только для чтения
+    std::shared_ptr<BalanceHistory> history_;   ///< 余额版本历史（未开启为空）/ История версий остатков (пусто, если выключена)
+    RuleEngine rules_;                          ///< 风控规则 / Правила контроля мошенничества
+    std::unique_ptr<io::OutputSink> alerts_;    ///< 规则触发输出（未开启为空）/ Вывод срабатываний (пусто, если выключено)
 
+#if BANK_PROFILE
+    OperationProfiler profiler_;                ///< 各操作类型的延迟 / Задержки по типам операций
+#endif
+    std::unique_ptr<io::OutputSink> profile_;   ///< 延迟统计输出（未开启为空）/ Вывод статистики задержек (пусто, если выключено)
+
+    // ==================== 派生状态数据 / Производные данные состояния ====================
     /**
-     * @brief 按币种统计的账户数量 / Количество счетов по валютам
+     * @brief 客户姓名到ID的索引 / Индекс имени клиента к ID
      * 
-     * 每个客户在不同币种上的活跃账户数，方便执行数量限制。
-     * 键：客户ID，值：数组[0]=RUB账户数, [1]=YUAN, [2]=USD, [3]=EUR。
+     * 支持按照"姓 名 父名"直接定位客户记录：加载的客户用完美哈希，
+     * 运行时新注册的客户进入溢出表；按 string_view 查找，不分配内存。
      * 
-     * Количество активных счетов каждого клиента по разным валютам для ограничения количества.
-     * Ключ: ID клиента, значение: массив [0]=счетов RUB, [1]=YUAN, [2]=USD, [3]=EUR.
+     * Поддержка прямой локализации записи клиента по "фамилия имя отчество":
+     * загруженные клиенты - в совершенном хеше, зарегистрированные во время работы -
+     * в таблице переполнения; поиск по string_view без выделения памяти.
      */
-    std::unordered_map<unsigned long long, std::array<unsigned long long, 4>> accountCountByCurrency_;
+    NameIndex clientNameToId_;
 
     /**
      * @brief 下一个可用的账户ID / Следующий доступный ID счёта
@@ -174,15 +563,51 @@ private:
     domain::DateTime currentTime_{};      ///< 当前模拟时间 / Текущее время симуляции
     bool bankDayStarted_{false};          ///< 银行营业日是否已开始 / Начался ли банковский день
     bool bankDayClosed_{false};           ///< 银行营业日是否已结束 / Завершился ли банковский день
+    bool halted_{false};                  ///< 银行违约，停止处理 / Дефолт банка, обработка остановлена
+    bool parallelLoad_{true};             ///< 是否并行解析初始数据 / Параллельный разбор начальных данных
+    DayStats dayStats_{};                 ///< 当前营业日统计 / Статистика текущего дня
+    std::vector<DayStats> dailyStats_;    ///< 已结束营业日统计 / Статистика завершённых дней
+
+    // ==================== 推测执行 / Спекулятивное выполнение ====================
+    std::size_t appealShards_{1};                 ///< 执行线程数 / Число потоков выполнения
+    std::unique_ptr<ThreadPool> appealPool_;      ///< 执行线程（顺序模式为空）/ Потоки выполнения (пусто в последовательном режиме)
+    std::vector<AppealRequest> appealBatch_;      ///< 积压的来访 / Накопленные обращения
+    std::size_t speculationWindow_{256};          ///< 每个推测窗口的来访数 / Обращений в окне спекуляции
+    std::uint32_t window_{1};                     ///< 当前推测窗口编号，提交时写入行的 window / Номер текущего окна, пишется в window строк при фиксации
+    SpeculationStats speculationStats_{};         ///< 推测执行统计 / Статистика спекуляции
+    AppealEffects serialEffects_;                 ///< 顺序模式复用的效果 / Эффекты, переиспользуемые в последовательном режиме
+
+    /**
+     * @brief 营业日内的单调分配区 / Монотонная арена банковского дня
+     * 
+     * 批次的临时对象（客户识别结果、分片列表、各来访的结果）只在写线程上从这里分配，
+     * 释放是空操作；营业日结束时整体归还。
+     * Временные объекты пакета (идентификация, списки шардов, результаты обращений)
+     * выделяются отсюда только потоком записи, освобождение - пустая операция; в конце
+     * банковского дня арена возвращается целиком.
+     */
+    std::pmr::monotonic_buffer_resource dayArena_{std::size_t{1} << 16};
+
+    // ==================== 输入缓冲 / Буфер ввода ====================
+    io::MappedInput input_;               ///< 映射到内存的输入 / Отображённый в память ввод
+    io::LineCursor cursor_;               ///< 事件流读取位置 / Позиция чтения потока событий
+
+    // ==================== 输出缓冲 / Буферы вывода ====================
+    io::OutputSink out_;                  ///< 业务响应（stdout）/ Ответы (stdout)
+    io::OutputSink log_;                  ///< 交易日志（stderr）/ Журнал транзакций (stderr)
 
     // ==================== 输入阶段：按题目顺序读取各个数据表 / Фаза ввода: чтение таблиц данных ====================
+    // 每个 readXxx 只解析自己的表片段，返回成功解析的行数；
+    // 行数小于 section.count 表示第该行解析失败。
+    // Каждая readXxx разбирает только свой фрагмент и возвращает число разобранных строк;
+    // значение меньше section.count означает ошибку в этой строке.
     /**
      * @brief 读取账户数据表 / Чтение таблицы счетов
      * 
      * 格式："Accounts %llu\n" 后跟 count 行账户记录。
      * Формат: "Accounts %llu\n" затем count строк записей счетов.
      */
-    void readAccounts();
+    unsigned long long readAccounts(const io::Section& section);
 
     /**
      * @brief 读取存款数据表 / Чтение таблицы депозитов
@@ -190,7 +615,7 @@ private:
      * 格式："Debits %llu\n" 后跟 count 行存款记录。
      * Формат: "Debits %llu\n" затем count строк записей депозитов.
      */
-    void readDeposits();
+    unsigned long long readDeposits(const io::Section& section);
 
     /**
      * @brief 读取贷款数据表 / Чтение таблицы кредитов
@@ -198,7 +623,7 @@ private:
      * 格式："Credits %llu\n" 后跟 count 行贷款记录。
      * Формат: "Credits %llu\n" затем count строк записей кредитов.
      */
-    void readLoans();
+    unsigned long long readLoans(const io::Section& section);
 
     /**
      * @brief 读取客户数据表 / Чтение таблицы клиентов
@@ -206,7 +631,7 @@ private:
      * 格式："Clients %llu\n" 后跟 count 行客户记录。
      * Формат: "Clients %llu\n" затем count строк записей клиентов.
      */
-    void readClients();
+    unsigned long long readClients(const io::Section& section);
 
     /**
      * @brief 读取客户账户关联表 / Чтение таблицы связей клиентов и счетов
@@ -214,7 +639,7 @@ private:
      * 格式："Client Debit %llu\n" 后跟 count 行关联记录。
      * Формат: "Client Debit %llu\n" затем count строк записей связей.
      */
-    void readClientAccounts();
+    unsigned long long readClientAccounts(const io::Section& section, std::vector<domain::ClientAccount>& relations);
 
     /**
      * @brief 读取银行内部账户表 / Чтение таблицы внутренних банковских счетов
@@ -222,7 +647,7 @@ private:
      * 格式："Bank Accounts %llu\n" 后跟 count 行账户ID。
      * Формат: "Bank Accounts %llu\n" затем count строк ID счетов.
      */
-    void readBankAccounts();
+    unsigned long long readBankAccounts(const io::Section& section);
 
     /**
      * @brief 读取客户债务表 / Чтение таблицы долгов клиентов
@@ -230,7 +655,7 @@ private:
      * 格式："Client Credit %llu\n" 后跟 count 行债务记录。
      * Формат: "Client Credit %llu\n" затем count строк записей долгов.
      */
-    void readClientDebts();
+    unsigned long long readClientDebts(const io::Section& section, std::vector<domain::ClientAccount>& relations);
 
     /**
      * @brief 读取工作岗位表 / Чтение таблицы рабочих мест
@@ -238,7 +663,7 @@ private:
      * 格式："Work Places %llu\n" 后跟 count 行岗位定义。
      * Формат: "Work Places %llu\n" затем count строк определений рабочих мест.
      */
-    void readWorkplaces();
+    unsigned long long readWorkplaces(const io::Section& section);
 
     /**
      * @brief 读取汇率表 / Чтение таблицы курсов обмена валют
@@ -246,16 +671,16 @@ private:
      * 格式："Exchange Rates %llu\n" 后跟 count 行汇率记录。
      * Формат: "Exchange Rates %llu\n" затем count строк записей курсов обмена.
      */
-    void readExchangeRates();
+    unsigned long long readExchangeRates(const io::Section& section);
 
     /**
      * @brief 构建派生状态 / Построение производного состояния
      * 
-     * 生成 accountOwners_、clientNameToId_、accountCountByCurrency_ 等派生结构，
+     * 填充账户行的所有者/币种、客户行的按币种计数以及 clientNameToId_，
      * 这些结构用于快速查找和权限校验。
      * 
-     * Генерирует производные структуры accountOwners_, clientNameToId_,
-     * accountCountByCurrency_ и т.д., используемые для быстрого поиска и проверки прав.
+     * Заполняет владельца/валюту в строках счетов, счётчики по валютам в строках
+     * клиентов и clientNameToId_, используемые для быстрого поиска и проверки прав.
      */
     void buildDerivedState();
 
@@ -314,7 +739,7 @@ private:
      * @param fallbackType 新客户的默认类型 / Тип по умолчанию для нового клиента
      * @return 客户指针（可能为新创建的）/ Указатель на клиента (возможно, только что созданного)
      */
-    domain::Client* ensureClientByName(const std::string& name, domain::CustomerKind fallbackType);
+    domain::Client* ensureClientByName(std::string_view name, domain::CustomerKind fallbackType);
 
     /**
      * @brief 根据姓名查找客户 / Поиск клиента по имени
@@ -322,7 +747,7 @@ private:
      * @param name 客户姓名 / Имя клиента
      * @return 客户指针，未找到返回 nullptr / Указатель на клиента, nullptr если не найден
      */
-    domain::Client* findClientByName(const std::string& name);
+    domain::Client* findClientByName(std::string_view name);
 
     /**
      * @brief 查找账户（const版本）/ Поиск счёта (const версия)
@@ -359,49 +784,312 @@ private:
 
     // ==================== 业务操作处理函数 / Функции обработки бизнес-операций ====================
     /**
-     * @brief 处理查询账户余额操作 / Обработка операции запроса баланса счёта
+     * @brief 读取来访的首行并预扫描操作行 / Чтение заголовка обращения и предварительный просмотр строк операций
+     * 
+     * 第一阶段：在输入缓冲上就地跳过操作行，只记下片段与新客户准入所需的标记，
+     * 不为操作行创建字符串；操作在第二阶段逐行解析执行。
+     * Первая фаза: строки операций пропускаются прямо в буфере ввода, запоминаются
+     * только фрагмент и признак для допуска нового клиента, строки не создаются;
+     * операции разбираются и выполняются построчно во второй фазе.
+     * 
+     * @return 出错时返回日志消息，否则 nullptr / Сообщение для журнала при ошибке, иначе nullptr
+     */
+    const char* readAppeal(const char* payload, AppealRequest& request);
+
+    /**
+     * @brief 识别客户，必要时注册新客户 / Идентификация клиента, при необходимости регистрация
+     * 
+     * 只能顺序调用：新客户编号按调用顺序分配。
+     * Вызывается только последовательно: номера новых клиентов выдаются в порядке вызовов.
+     */
+    Admission admitAppeal(const AppealRequest& request);
+
+    /**
+     * @brief 顺序处理一次来访：逐行执行并立即提交 / Последовательная обработка обращения: построчное выполнение и фиксация
+     * 
+     * 不保存中间结果，内存占用与操作数无关。
+     * Промежуточные результаты не хранятся, память не зависит от числа операций.
+     */
+    void processAppeal(const AppealRequest& request, const Admission& admission);
+
+    /**
+     * @brief 执行一行操作 / Выполнение одной строки операции
+     * 
+     * 与 executeAppeal 相同，只写 effects。
+     * Как и executeAppeal, пишет только в effects.
+     */
+    OpResult executeOperation(const ClientRow& clientRow,
+                              const Admission& admission,
+                              AppealEffects& effects,
+                              domain::Operation kind,
+                              std::string_view line) const;
+
+    /**
+     * @brief 执行来访中的全部操作 / Выполнение всех операций обращения
+     * 
+     * 只读共享状态，效果与读集写入 effects，因此任意来访都可以在不同线程上同时执行；
+     * 余额只在提交阶段经 ledger_ 过账。
+     * Общее состояние только читается, эффекты и множество чтения пишутся в effects,
+     * поэтому любые обращения могут выполняться одновременно в разных потоках; остатки
+     * меняются только при фиксации через ledger_.
+     */
+    void executeAppeal(const AppealRequest& request,
+                       const Admission& admission,
+                       AppealEffects& effects,
+                       std::pmr::vector<OpResult>& results) const;
+
+    /// 读集是否被本窗口内更早的提交修改过 / Изменено ли множество чтения более ранней фиксацией окна
+    bool speculationStale(const Admission& admission, const AppealEffects& effects) const;
+
+    /**
+     * @brief 查询账户余额 / Запрос баланса счёта
      * 
      * 客户可以查询其拥有的任何账户的余额。需要权限校验。
      * Клиент может запросить баланс любого своего счёта. Требуется проверка прав.
      */
-    void handleBalanceInquiry(domain::Client& client,
-                              unsigned long long accountId,
-                              unsigned long long day,
-                              unsigned long long hour,
-                              unsigned long long minute);
+    OpResult evaluateBalanceInquiry(unsigned long long clientId, unsigned long long accountId, AppealEffects& effects) const;
+
+    /**
+     * @brief 开户 / Открытие счёта
+     * 
+     * 检查账户数量限制（含本来访已批准的开户与销户）并计算手续费；账号在提交阶段分配。
+     * Проверка лимита счетов (с учётом одобренных в обращении открытий и закрытий) и расчёт
+     * комиссии; номер счёта выдаётся при фиксации.
+     */
+    OpResult evaluateCreateAccount(const ClientRow& clientRow,
+                                   domain::CustomerKind kind,
+                                   domain::Currency currency,
+                                   AppealEffects& effects) const;
+
+    /**
+     * @brief 销户（执行阶段）/ Закрытие счёта (этап выполнения)
+     * 
+     * 校验所有权与余额、计算手续费，销户记入 effects，同一来访中随后的开户就能用上
+     * 空出的名额；账户在提交阶段关闭并扣除余额。
+     * Проверка владельца и остатка, расчёт комиссии; закрытие записывается в effects, так что
+     * следующее открытие в том же обращении видит освободившийся лимит; счёт закрывается и
+     * остаток списывается при фиксации.
+     */
+    OpResult evaluateCloseAccount(const ClientRow& clientRow, unsigned long long accountId, AppealEffects& effects) const;
+
+    /**
+     * @brief 销户的校验与计算，执行与提交阶段共用 / Проверка и расчёт закрытия, общие для выполнения и фиксации
+     * 
+     * @param balance 校验所用的余额 / Остаток, по которому идёт проверка
+     */
+    OpResult prepareClose(const AccountRow& row, unsigned long long clientId, domain::Money balance) const;
+
+    /**
+     * @brief 充值或取款（执行阶段）/ Пополнение или снятие (этап выполнения)
+     * 
+     * 按执行阶段的预计余额（余额 + 本来访已批准的变动）校验，并把变动记入 effects；
+     * 今天新开的账户留到提交阶段再校验。
+     * Проверка по ожидаемому остатку (остаток + одобренные в обращении изменения),
+     * изменение записывается в effects; открытые сегодня счета проверяются при фиксации.
+     */
+    OpResult evaluatePosting(const ClientRow& clientRow,
+                             domain::Operation operation,
+                             std::string_view line,
+                             AppealEffects& effects) const;
+
+    /**
+     * @brief 充值/取款的校验与手续费计算 / Проверка пополнения/снятия и расчёт комиссии
+     * 
+     * @param projected 校验所用的余额 / Остаток, по которому идёт проверка
+     */
+    OpResult preparePosting(const AccountRow& row,
+                            unsigned long long clientId,
+                            domain::Operation operation,
+                            domain::Money amount,
+                            domain::Money projected) const;
+
+    /// 充值/取款的提交：过账、写响应 / Фиксация пополнения/снятия: проводка и ответ
+    void commitPosting(unsigned long long day,
+                       unsigned long long hour,
+                       unsigned long long minute,
+                       AccountRow& row,
+                       const OpResult& result);
+
+    /**
+     * @brief 校验 ledger_ 中的批次 / Проверка пакета из ledger_
+     * 
+     * 一次遍历解析账户行，并按批次顺序用滚动余额校验 checked 分录（前面的
+     * 贷记可以覆盖后面的借记）；余额不变。
+     * Один проход: поиск строк счетов и проверка checked-проводок по текущему остатку
+     * в порядке пакета (предшествующее зачисление покрывает последующее списание);
+     * остатки не меняются.
+     * 
+     * @return 第一笔不能过账的分录下标；全部可过账时为批次大小
+     *         Индекс первой невыполнимой проводки; размер пакета, если выполнимы все
+     */
+    std::size_t checkPostings();
+
+    /**
+     * @brief 过账批次的前 count 笔并清空批次 / Проводка первых count проводок пакета и очистка
+     * 
+     * 使用 checkPostings 解析出的账户行：修改余额、写交易日志并记入账簿。
+     * Использует строки, найденные checkPostings: меняет остатки, пишет журнал транзакций и книгу.
+     */
+    void applyPostings(std::size_t count, unsigned long long day, unsigned long long hour, unsigned long long minute);
+
+    /// 账户加入所有者的活跃索引 / Добавление счёта в индекс активных счетов владельца
+    static void indexAccount(ClientRow& clientRow, AccountRow& row);
+
+    /// 账户移出所有者的活跃索引并标记为关闭 / Удаление счёта из индекса владельца и пометка закрытым
+    void closeAccount(AccountRow& row);
+
+    /// 按原始顺序提交结果：分配账号、过账、写出响应与日志 / Фиксация результатов: номера счетов, проводки, ответы и журнал
+    void commitAppeal(const AppealRequest& request,
+                      const Admission& admission,
+                      const std::pmr::vector<OpResult>& results);
+
+    /**
+     * @brief 提交一个操作结果 / Фиксация результата одной операции
+     * 
+     * @return false 表示银行违约，来访中其余操作不再提交 / false - дефолт банка, остальные операции не фиксируются
+     */
+    bool commitOperation(const AppealRequest& request, const Admission& admission, const OpResult& result);
+
+    /// 销户的提交：过账全部余额、写响应 / Фиксация закрытия: проводка всего остатка и ответ
+    void commitClose(unsigned long long day,
+                     unsigned long long hour,
+                     unsigned long long minute,
+                     AccountRow& row,
+                     const OpResult& result);
+
+    /**
+     * @brief 货币兑换（执行阶段）/ Обмен валюты (этап выполнения)
+     * 
+     * 只解析与换算；内部账户余额依赖提交顺序，留到提交阶段检查。
+     * Только разбор и пересчёт; остаток внутреннего счёта зависит от порядка фиксации
+     * и проверяется на этапе фиксации.
+     */
+    OpResult evaluateCurrencyExchange(std::string_view line) const;
+
+    /// 插入新账户及其客户关系 / Вставка нового счёта и связи с клиентом
+    void insertAccount(unsigned long long accountId,
+                       unsigned long long clientId,
+                       domain::Currency currency,
+                       domain::AccountKind kind,
+                       domain::Money balance);
+
+    /// 营业日提交：日志落盘，必要时写快照 / Фиксация дня: журнал на диск, при необходимости снимок
+    void commitJournalDay(unsigned long long day);
+
+    /// 序列化账户、客户与关系 / Сериализация счетов, клиентов и связей
+    std::string encodeSnapshot(unsigned long long day, std::size_t inputOffset) const;
+
+    /**
+     * @brief 从快照恢复 / Восстановление из снимка
+     * 
+     * @param inputOffset 输出：快照对应的输入偏移 / Выход: смещение ввода снимка
+     */
+    bool restoreSnapshot(const std::string& data, unsigned long long& day, std::size_t& inputOffset);
+
+    /// 重放一条已提交的日志记录（不再写日志）/ Повтор зафиксированной записи (без повторного журналирования)
+    void replayRecord(const JournalRecord& record);
+
+    /**
+     * @brief 按周期计息并批量过账 / Начисление процентов за период и пакетная проводка
+     * 
+     * 先处理所有贷款，再处理所有存款（题目要求）。内部账户不足时银行违约，
+     * 贷款账户不足时客户违约，两者都会停止模拟。
+     * Сначала все кредиты, затем все депозиты (по условию). Нехватка на внутреннем
+     * счёте - дефолт банка, на кредитном счёте - дефолт клиента; оба останавливают симуляцию.
+     */
+    void accrueInterest(unsigned long long day, AccrualPeriod period);
+
+    /// 修改余额并维护当日最低余额 / Изменение остатка с учётом минимума за день
+    void changeBalance(AccountRow& row, domain::Money delta);
+
+    /// 当日最低余额（当天未变动时即当前余额）/ Минимальный остаток за день (без движений - текущий)
+    domain::Money dayMinimum(const AccountRow& row, unsigned long long day) const;
+
+    /// 登记来访的客户（及新客户注册）/ Регистрация клиента обращения (и регистрации нового клиента)
+    void scheduleAppeal(const AppealRequest& request, const Admission& admission);
+
+    /// 登记一个操作的服务时长（未开放的业务不占用岗位）/ Регистрация длительности операции (недоступные услуги не занимают место)
+    void scheduleOperation(const Admission& admission, domain::Operation kind, const OpResult& result);
+
+    /// 是否为银行内部账户 / Является ли внутренним счётом банка
+    bool isBankInternalAccount(const AccountRow& row) const;
+
+    /// 按窗口推测执行并提交积压的来访 / Спекулятивное выполнение окнами и фиксация накопленных обращений
+    void flushAppealBatch();
 
     /**
-     * @brief 处理开户操作 / Обработка операции открытия счёта
+     * @brief 推测执行并提交积压来访中的 [begin, end) / Спекулятивное выполнение и фиксация обращений [begin, end) пакета
      * 
-     * 客户可以开立结算账户。需要检查账户数量限制、计算手续费、创建账户和存款记录。
-     * Клиент может открыть расчётный счёт. Требуется проверка ограничений количества,
-     * расчёт комиссии, создание записей счёта и депозита.
+     * 顺序识别客户，在线程池上并行执行（线程依次领取下一个来访），再按原始顺序验证读集并提交；
+     * 推测失效或依赖提交结果的来访在提交位置按顺序模式重新执行。
+     * Последовательная идентификация клиентов, параллельное выполнение на пуле (потоки берут
+     * следующее обращение по очереди), затем проверка множеств чтения и фиксация в исходном
+     * порядке; обращения с устаревшей спекуляцией или зависящие от фиксации выполняются
+     * заново на своём месте в последовательном режиме.
      */
-    void handleCreateAccount(domain::Client& client,
-                             domain::CustomerKind kind,
-                             const std::string& currency,
-                             unsigned long long day,
-                             unsigned long long hour,
-                             unsigned long long minute);
+    void speculateWindow(std::size_t begin, std::size_t end);
 
     // ==================== 统一日志输出，满足题目"交易日志"要求 / Единый вывод логов ====================
     /**
      * @brief 记录错误消息 / Запись сообщения об ошибке
      * 
-     * 输出到 stderr。
-     * Вывод в stderr.
+     * 写入交易日志通道（stderr）。
+     * Запись в канал журнала (stderr).
      * 
      * @param message 错误消息 / Сообщение об ошибке
      */
     void logError(const char* message);
 
+    /**
+     * @brief 输出一条业务响应 / Вывод одного ответа
+     * 
+     * 格式："%llu # %llu:%llu # <message>\n"
+     * Формат: "%llu # %llu:%llu # <message>\n"
+     */
+    void respond(unsigned long long day,
+                 unsigned long long hour,
+                 unsigned long long minute,
+                 std::string_view message);
+
+    /**
+     * @brief 刷新响应与日志缓冲 / Сброс буферов ответов и журнала
+     * 
+     * 在营业日结束、事件流结束以及异常退出前调用。
+     * Вызывается в конце банковского дня, в конце потока событий и перед аварийным выходом.
+     */
+    void flushOutput();
+
+    /// 把账户表写成当天的列式行组 / Запись таблицы счетов группой строк за день
+    void exportColumns(unsigned long long day);
+
+    /**
+     * @brief 复制账户表并发布到查询服务（写线程）/ Копия таблицы счетов и публикация в сервис запросов (поток записи)
+     * 
+     * @param final 输入已结束：历史不再变化，随快照一起发布 / Ввод закончен: история больше не меняется и публикуется со снимком
+     */
+    void publishSnapshot(bool final = false);
+
+    /**
+     * @brief 银行违约：输出 "Bank defaulted" 并停止处理 / Дефолт банка: вывод "Bank defaulted" и остановка
+     */
+    void defaultBank(unsigned long long day, unsigned long long hour, unsigned long long minute);
+
+    /// 客户违约：输出 "Client defaulted" 并停止模拟 / Дефолт клиента: "Client defaulted" и остановка симуляции
+    void defaultClient(unsigned long long day, unsigned long long hour, unsigned long long minute);
+
+    /// 输出终止消息并停止 / Вывод завершающего сообщения и остановка
+    void halt(unsigned long long day, unsigned long long hour, unsigned long long minute, const char* message);
+
+    /// 写出规则触发 / Вывод срабатываний правил
+    void reportAlerts(std::span<const RuleAlert> alerts, unsigned long long day, unsigned long long hour, unsigned long long minute);
+
     /**
      * @brief 记录账户间转账日志 / Запись лога перевода между счетами
      * 
-     * 按照题目要求的格式输出到 stderr，记录所有资金流动。
+     * 按照题目要求的格式写入日志缓冲，记录所有资金流动。
      * 格式："%llu # %llu:%llu # %llu -> %llu # %llu.%llu\n"
      * 
-     * Вывод в stderr в формате, требуемом задачей, для записи всех денежных потоков.
+     * Запись в буфер журнала в формате, требуемом задачей, для всех денежных потоков.
      * Формат: "%llu # %llu:%llu # %llu -> %llu # %llu.%llu\n"
      */
     void logAccountTransfer(unsigned long long day,
@@ -409,7 +1097,21 @@ private:
                             unsigned long long minute,
                             unsigned long long fromAccount,
                             unsigned long long toAccount,
-                            double amount) const;
+                            domain::Money amount);
+
+    /// 账户充值日志："%llu # %llu:%llu # -> %llu # %llu.%llu\n" / Журнал пополнения счёта
+    void logAccountDeposit(unsigned long long day,
+                           unsigned long long hour,
+                           unsigned long long minute,
+                           unsigned long long toAccount,
+                           domain::Money amount);
+
+    /// 从账户提款日志："%llu # %llu:%llu # %llu -> # %llu.%llu\n" / Журнал снятия со счёта
+    void logAccountWithdrawal(unsigned long long day,
+                              unsigned long long hour,
+                              unsigned long long minute,
+                              unsigned long long fromAccount,
+                              domain::Money amount);
 };
 
 }  // namespace bank
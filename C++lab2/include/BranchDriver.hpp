@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file BranchDriver.hpp
+ * @brief 多分行并行模拟驱动 / Драйвер параллельной симуляции многих отделений
+ *
+ * 每个分行是一个独立的 BankSystem：各自的输入流与输出文件，互不共享状态。
+ * 驱动把所有分行放到工作窃取线程池上运行，最后按营业日汇总统计，
+ * 代替容量规划时"每个分行启动一个进程"的做法。
+ *
+ * Каждое отделение - независимый BankSystem со своим входным потоком и файлами
+ * вывода, без общего состояния. Драйвер запускает все отделения на пуле потоков
+ * с перехватом задач и затем сводит статистику по банковским дням, заменяя
+ * "по процессу на отделение" при планировании мощностей.
+ */
+
+#include "Bank.hpp"
+
+#include <string>
+#include <vector>
+
+namespace bank {
+
+/**
+ * @brief 一个分行的输入与输出位置 / Вход и выходы одного отделения
+ */
+struct BranchJob {
+    std::string inputPath;      ///< 初始数据与事件流 / Начальные данные и поток событий
+    std::string outputPath;     ///< 业务响应 / Ответы
+    std::string logPath;        ///< 交易日志 / Журнал транзакций
+};
+
+/**
+ * @brief 一个分行的运行结果 / Результат работы одного отделения
+ */
+struct BranchResult {
+    std::string inputPath;                          ///< 分行输入 / Вход отделения
+    bool loaded{false};                             ///< 初始数据是否加载成功 / Загружены ли начальные данные
+    bool completed{false};                          ///< 是否处理完整个事件流 / Обработан ли весь поток событий
+    std::vector<BankSystem::DayStats> days;         ///< 各营业日统计 / Статистика по дням
+};
+
+/**
+ * @brief 所有分行在同一营业日的汇总 / Сводка всех отделений за один банковский день
+ */
+struct DaySummary {
+    unsigned long long day{};           ///< 营业日 / Банковский день
+    unsigned long long branches{};      ///< 当日营业的分行数 / Работавших отделений
+    unsigned long long appeals{};       ///< 客户来访数 / Обращений
+    unsigned long long operations{};    ///< 操作数 / Операций
+    unsigned long long transfers{};     ///< 转账数 / Переводов
+    std::array<domain::Money, domain::kCurrencyCount> fees{};  ///< 按币种的手续费收入 / Комиссии по валютам
+    unsigned long long customers{};     ///< 排队的客户 / Клиентов в очередях
+    unsigned long long turnedAway{};    ///< 营业结束未办完 / Не обслуженных до закрытия
+    std::vector<unsigned long long> waitHistogram;  ///< 合并的等待直方图 / Объединённая гистограмма ожидания
+};
+
+/**
+ * @brief 并行运行所有分行 / Параллельный запуск всех отделений
+ *
+ * 输入较大的分行先提交，减少尾部等待。结果顺序与 jobs 相同。
+ * Отделения с большим вводом отправляются первыми, чтобы сократить хвост.
+ * Порядок результатов совпадает с jobs.
+ *
+ * @param threads 线程数，0 表示硬件并发数 / Число потоков, 0 - аппаратный параллелизм
+ */
+std::vector<BranchResult> runBranches(const std::vector<BranchJob>& jobs, std::size_t threads = 0);
+
+/**
+ * @brief 按营业日汇总 / Сводка по банковским дням
+ *
+ * @return 按营业日升序的汇总 / Сводки по возрастанию дня
+ */
+std::vector<DaySummary> summarizeDays(const std::vector<BranchResult>& results);
+
+/**
+ * @brief 输出日报 / Вывод дневного отчёта
+ *
+ * 每行："day # branches # appeals # operations # transfers # RUB # YUAN # USD # EUR
+ *        # customers # turned away # wait p50 # wait p90 # wait p99"（等待以分钟计）
+ * Строка: то же; ожидание в минутах
+ */
+void writeDaySummary(io::OutputSink& out, const std::vector<DaySummary>& summary);
+
+}  // namespace bank
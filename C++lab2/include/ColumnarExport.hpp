@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file ColumnarExport.hpp
+ * @brief 营业日结束时的列式导出 / Колоночная выгрузка в конце банковского дня
+ *
+ * 每个营业日结束时把全部账户写成一个行组（row group）追加到文件，每列的值连续存放，
+ * 分析程序可以只读需要的列，直接把整列映射为数组，不必再解析 printf 文本与交易日志。
+ * 币种、账户类型等小取值域的列按字典编码：列头给出字典，值是 uint8 下标。
+ * 所有整数按本机字节序（与预写日志、账簿相同）。
+ *
+ * По окончании каждого банковского дня все счета пишутся одной группой строк (row group),
+ * дописываемой в файл; значения столбца лежат подряд, поэтому аналитика читает только
+ * нужные столбцы и отображает столбец целиком в массив без разбора вывода printf и
+ * журнала переводов. Столбцы с малым множеством значений (валюта, тип счёта) кодируются
+ * словарём: в заголовке столбца словарь, значения - индексы uint8. Целые - в порядке байт
+ * машины (как в журнале предзаписи и книге).
+ *
+ * 文件布局 / Формат файла:
+ *   "BNKCOL01"                                             文件头 / заголовок файла
+ *   行组 / группа строк:
+ *     u32 kRowGroupMagic, u32 day, u64 rows, u16 columns
+ *     每列 / столбец:
+ *       u16 长度 + 列名 / длина + имя, u8 ColumnType, u8 ColumnEncoding,
+ *       u16 字典大小 + 各项 (u16 长度 + 文本) / размер словаря + элементы (u16 длина + текст),
+ *       u64 字节数 / число байт, 值 / значения
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace bank {
+
+/// 列的物理类型 / Физический тип столбца
+enum class ColumnType : std::uint8_t {
+    UInt8 = 1,
+    UInt32 = 2,
+    UInt64 = 3,
+    Int64 = 4,
+};
+
+/// 列的编码 / Кодирование столбца
+enum class ColumnEncoding : std::uint8_t {
+    Plain = 0,          ///< 原值 / Значения как есть
+    Dictionary = 1,     ///< uint8 字典下标 / Индексы словаря uint8
+};
+
+/// 读回的一列 / Прочитанный столбец
+struct ColumnarColumn {
+    std::string name;
+    ColumnType type{ColumnType::UInt8};
+    ColumnEncoding encoding{ColumnEncoding::Plain};
+    std::vector<std::string> dictionary;
+    std::string values;             ///< 原始字节 / Сырые байты
+
+    /// 第 row 行的值 / Значение строки row
+    template <typename T>
+    T at(std::size_t row) const {
+        T value{};
+        std::memcpy(&value, values.data() + row * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    /// 字典列第 row 行的文本 / Текст строки row столбца-словаря
+    std::string_view text(std::size_t row) const { return dictionary.at(at<std::uint8_t>(row)); }
+};
+
+/// 读回的一个行组 / Прочитанная группа строк
+struct ColumnarRowGroup {
+    std::uint32_t day{};
+    std::uint64_t rows{};
+    std::vector<ColumnarColumn> columns;
+
+    /// 按列名查找，不存在返回 nullptr / Поиск столбца по имени, nullptr если нет
+    const ColumnarColumn* column(std::string_view name) const;
+};
+
+/**
+ * @brief 列式文件的流式写入 / Потоковая запись колоночного файла
+ *
+ * 列按顺序写出：beginColumn 之后恰好调用 rows 次 value，值经固定大小的缓冲直接写入文件，
+ * 不在内存中组装整个行组。
+ * Столбцы пишутся по очереди: после beginColumn ровно rows вызовов value; значения через
+ * буфер фиксированного размера сразу идут в файл, группа строк целиком в памяти не собирается.
+ */
+class ColumnarWriter {
+public:
+    static constexpr std::uint32_t kRowGroupMagic = 0x47524342;     ///< "BCRG"
+    static constexpr std::string_view kFileMagic = "BNKCOL01";
+
+    ColumnarWriter() = default;
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /// 以追加方式打开；新文件先写文件头 / Открытие на дозапись; в новый файл пишется заголовок
+    bool open(const std::string& path);
+    bool recording() const { return file_ != nullptr; }
+
+    void beginRowGroup(std::uint32_t day, std::uint64_t rows, std::uint16_t columns);
+    void beginColumn(std::string_view name, ColumnType type, std::span<const std::string_view> dictionary = {});
+
+    template <typename T>
+    void value(T v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (buffer_.size() - used_ < sizeof(T)) drain();
+        std::memcpy(buffer_.data() + used_, &v, sizeof(T));
+        used_ += sizeof(T);
+    }
+
+    /// 写出剩余缓冲；返回此前所有写入是否成功 / Запись остатка буфера; успешны ли все записи
+    bool endRowGroup();
+
+    void close();
+
+private:
+    void drain();
+    void raw(const void* data, std::size_t size);
+    void text(std::string_view value);
+
+    std::FILE* file_{nullptr};
+    std::vector<char> buffer_ = std::vector<char>(std::size_t{1} << 16);
+    std::size_t used_{0};
+    std::uint64_t rows_{0};
+    bool failed_{false};
+};
+
+/// 读取整个列式文件；不完整的行组忽略 / Чтение колоночного файла; неполная группа строк игнорируется
+bool readColumnar(const std::string& path, std::vector<ColumnarRowGroup>& groups);
+
+/// 每个值的字节数 / Байт на значение
+std::size_t columnWidth(ColumnType type);
+
+}  // namespace bank
@@ -0,0 +1,166 @@
+#pragma once
+
+/**
+ * @file DenseTable.hpp
+ * @brief 按编号直接索引的稠密表 / Плотная таблица с прямой индексацией по номеру
+ *
+ * 账户、客户、存款、贷款的编号都是连续分配的（nextAccountId_/nextClientId_），
+ * 因此用 "编号 - 基准" 作为 vector 下标即可，查找无需哈希、无需指针追逐。
+ *
+ * Номера счетов, клиентов, депозитов и кредитов выдаются подряд
+ * (nextAccountId_/nextClientId_), поэтому индексом vector служит "номер - база":
+ * поиск без хеширования и без перехода по указателям.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bank {
+
+/**
+ * @brief 稠密表 / Плотная таблица
+ *
+ * 编号落在稠密窗口（最多 kMaxSpan 个槽）内时直接索引；极少数离群编号
+ * 放入溢出哈希表，保证任意输入都能正确存取。
+ * 插入可能使已取得的指针失效（与 std::vector 相同）。
+ *
+ * Номера внутри плотного окна (не более kMaxSpan ячеек) индексируются напрямую;
+ * редкие выбросы попадают в хеш-таблицу переполнения, чтобы любой ввод
+ * обрабатывался корректно. Вставка может инвалидировать указатели (как у std::vector).
+ */
+template <typename T>
+class DenseTable {
+public:
+    static constexpr std::size_t kMaxSpan = std::size_t{1} << 24;
+
+    void reserve(std::size_t count) {
+        rows_.reserve(count);
+        present_.reserve(count);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    bool contains(unsigned long long id) const { return find(id) != nullptr; }
+
+    T* find(unsigned long long id) {
+        return const_cast<T*>(static_cast<const DenseTable&>(*this).find(id));
+    }
+
+    const T* find(unsigned long long id) const {
+        if (id >= base_ && id - base_ < rows_.size()) {
+            const auto slot = static_cast<std::size_t>(id - base_);
+            if (present_[slot]) return &rows_[slot];
+        }
+        // 窗口扩展后，早先的离群编号可能落入窗口内，因此仍需查溢出表。
+        if (overflow_.empty()) return nullptr;
+        auto it = overflow_.find(id);
+        return it == overflow_.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief 插入记录（已存在则保持原值）/ Вставка записи (существующая не перезаписывается)
+     *
+     * 语义与 unordered_map::emplace 相同。/ Семантика как у unordered_map::emplace.
+     *
+     * @return (记录指针, 是否新插入) / (указатель на запись, вставлена ли)
+     */
+    std::pair<T*, bool> emplace(unsigned long long id, T value) {
+        if (T* existing = find(id)) return {existing, false};
+        if (!fitWindow(id)) {
+            auto [it, inserted] = overflow_.emplace(id, std::move(value));
+            ++size_;
+            return {&it->second, inserted};
+        }
+        const auto slot = static_cast<std::size_t>(id - base_);
+        // 就地重新构造而不是赋值：带 pmr 分配器的行保留自己的内存资源
+        // Повторное конструирование вместо присваивания: строки с pmr-аллокатором сохраняют свой ресурс
+        std::destroy_at(&rows_[slot]);
+        std::construct_at(&rows_[slot], std::move(value));
+        present_[slot] = 1;
+        ++size_;
+        return {&rows_[slot], true};
+    }
+
+    /// 最大编号（表为空时返回 0）/ Максимальный номер (0 для пустой таблицы)
+    unsigned long long maxId() const {
+        unsigned long long result = 0;
+        for (std::size_t slot = rows_.size(); slot > 0; --slot) {
+            if (present_[slot - 1]) {
+                result = base_ + slot - 1;
+                break;
+            }
+        }
+        for (const auto& [id, _] : overflow_) {
+            if (id > result) result = id;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 按编号升序遍历稠密部分，再遍历溢出部分 / Обход плотной части по возрастанию, затем переполнения
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (std::size_t slot = 0; slot < rows_.size(); ++slot) {
+            if (present_[slot]) fn(base_ + slot, rows_[slot]);
+        }
+        for (auto& [id, row] : overflow_) fn(id, row);
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (std::size_t slot = 0; slot < rows_.size(); ++slot) {
+            if (present_[slot]) fn(base_ + slot, rows_[slot]);
+        }
+        for (const auto& [id, row] : overflow_) fn(id, row);
+    }
+
+private:
+    /**
+     * @brief 扩展窗口以容纳 id / Расширение окна под id
+     *
+     * @return false 表示 id 离窗口太远，应放入溢出表 / false - id слишком далеко, идёт в переполнение
+     */
+    bool fitWindow(unsigned long long id) {
+        if (rows_.empty()) {
+            base_ = id;
+            rows_.resize(1);
+            present_.resize(1);
+            return true;
+        }
+        if (id >= base_) {
+            const auto slot = id - base_;
+            if (slot < rows_.size()) return true;
+            if (slot >= kMaxSpan) return false;
+            const auto wanted = static_cast<std::size_t>(slot) + 1;
+            const auto grown = std::max(wanted, rows_.size() + rows_.size() / 2);
+            const auto target = std::min<std::size_t>(grown, kMaxSpan);
+            rows_.resize(target);
+            present_.resize(target);
+            return true;
+        }
+        // id 在基准之前：向前扩展并预留同样大小的余量，避免降序输入退化为 O(n^2)。
+        // id перед базой: расширяемся вперёд с запасом, чтобы убывающий ввод не давал O(n^2).
+        const auto gap = base_ - id;
+        if (gap + rows_.size() > kMaxSpan) return false;
+        const auto headroom = std::min<unsigned long long>(id, std::min<unsigned long long>(rows_.size(), kMaxSpan - rows_.size() - gap));
+        const auto shift = static_cast<std::size_t>(gap + headroom);
+        rows_.insert(rows_.begin(), shift, T{});
+        present_.insert(present_.begin(), shift, 0);
+        base_ -= shift;
+        return true;
+    }
+
+    unsigned long long base_{0};                        ///< 下标 0 对应的编号 / Номер для индекса 0
+    std::vector<T> rows_;                               ///< 记录 / Записи
+    std::vector<unsigned char> present_;                ///< 槽位是否有效 / Занята ли ячейка
+    std::unordered_map<unsigned long long, T> overflow_;  ///< 离群编号 / Выбросы
+    std::size_t size_{0};                               ///< 记录数 / Количество записей
+};
+
+}  // namespace bank
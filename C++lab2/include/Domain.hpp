@@ -84,7 +84,8 @@ inline bool operator==(const DateTime &lhs, const DateTime &rhs) {
 enum class AccountKind {
     Debit,      ///< 借记账户 / Дебетовый счёт
     Deposit,    ///< 存款账户 / Депозитный счёт
-    Credit      ///< 贷款账户 / Кредитный счёт
+    Credit,     ///< 贷款账户 / Кредитный счёт
+    Unknown     ///< 未知类型 / Неизвестный тип
 };
 
 /**
@@ -118,6 +119,15 @@ enum class CustomerKind {
     NotClient       ///< 非客户 / Не клиент
 };
 
+/**
+ * @brief 枚举取值个数（不含 Unknown/NotClient）/ Число значений перечислений (без Unknown/NotClient)
+ * 
+ * 用作按币种、客户类型直接索引的平坦数组的维度。
+ * Размерности плоских массивов, индексируемых напрямую по валюте и типу клиента.
+ */
+constexpr std::size_t kCurrencyCount = 4;
+constexpr std::size_t kCustomerKindCount = 4;
+
 /**
  * @brief 工作岗位类型枚举 / Перечисление типов рабочих мест
  * 
@@ -134,28 +144,128 @@ enum class WorkplaceKind {
     Unknown             ///< 未知类型 / Неизвестный тип
 };
 
+constexpr std::size_t kWorkplaceKindCount = static_cast<std::size_t>(WorkplaceKind::Unknown);
+
+/**
+ * @brief 客户业务操作枚举 / Перечисление операций клиента
+ * 
+ * Personal Appeal 中每行操作只按前缀解析一次，之后按枚举分发与查权限表。
+ * Каждая строка операции Personal Appeal разбирается по префиксу один раз,
+ * дальше диспетчеризация и проверка прав идут по перечислению.
+ */
+enum class Operation {
+    BalanceInquiry,     ///< 查询余额 / Запрос баланса
+    CreateAccount,      ///< 开户 / Открытие счёта
+    CloseAccount,       ///< 销户 / Закрытие счёта
+    WithdrawFunds,      ///< 取款 / Снятие средств
+    TopUpFunds,         ///< 存入 / Пополнение
+    CurrencyExchange,   ///< 货币兑换 / Обмен валюты
+    RequestDebitCard,   ///< 申请借记卡 / Запрос дебетовой карты
+    Unknown             ///< 未知操作 / Неизвестная операция
+};
+
+constexpr std::size_t kOperationCount = static_cast<std::size_t>(Operation::Unknown);
+
+/**
+ * @brief 定点货币金额 / Денежная сумма с фиксированной точкой
+ * 
+ * 金额以 int64 的"千分之一货币单位"保存，加减法完全精确，
+ * 不再需要在每次使用时对 double 做四舍五入。
+ * 题目要求的四舍五入公式：(((long long int)(x * 10000) + 5 * (x < 0.0 ? -1 : 1)) / 10) / 1000.0
+ * 只在 double 参与计算（利率、百分比手续费）时通过 fromDouble 使用一次。
+ * 示例：round(999999.0004) == 999999.000; round(-999999.0005) == -999999.001
+ * 
+ * Сумма хранится как int64 в "тысячных долях денежной единицы": сложение и
+ * вычитание точны, округлять double при каждом использовании больше не нужно.
+ * Формула округления из задачи: (((long long int)(x * 10000) + 5 * (x < 0.0 ? -1 : 1)) / 10) / 1000.0
+ * применяется один раз через fromDouble, только когда в расчёте участвует double
+ * (процентные ставки, процентные комиссии).
+ * Примеры: round(999999.0004) == 999999.000; round(-999999.0005) == -999999.001
+ */
+struct Money {
+    static constexpr std::int64_t kScale = 1000;   ///< 千分位 / Тысячные доли
+
+    std::int64_t thousandths{};     ///< 金额（千分之一单位）/ Сумма (в тысячных долях)
+
+    /**
+     * @brief 四舍五入到小数点后3位 / Округление до 3 знаков после запятой
+     * 
+     * @param x 待四舍五入的数值 / Значение для округления
+     * @return 四舍五入后的结果 / Результат округления
+     */
+    static double round3(double x) {
+        const auto sign = x < 0.0 ? -1.0 : 1.0;
+        long long scaled = static_cast<long long>(x * 10000.0 + 5.0 * sign);
+        return static_cast<double>(scaled / 10) / 1000.0;
+    }
+
+    /// 由千分位整数构造 / Построение из целого числа тысячных
+    static constexpr Money fromThousandths(std::int64_t value) { return Money{value}; }
+
+    /// 由整货币单位构造 / Построение из целых денежных единиц
+    static constexpr Money fromUnits(std::int64_t units) { return Money{units * kScale}; }
+
+    /**
+     * @brief 由 double 构造，按题目公式四舍五入 / Построение из double с округлением по формуле задачи
+     */
+    static Money fromDouble(double x) {
+        const auto sign = x < 0.0 ? -1.0 : 1.0;
+        return Money{static_cast<std::int64_t>(x * 10000.0 + 5.0 * sign) / 10};
+    }
+
+    /// 转换为 double（仅用于与利率相乘等场景）/ Преобразование в double (только для умножения на ставки и т.п.)
+    constexpr double toDouble() const { return static_cast<double>(thousandths) / static_cast<double>(kScale); }
+
+    /**
+     * @brief 按系数缩放并四舍五入 / Масштабирование на коэффициент с округлением
+     * 
+     * 用于百分比手续费与利息：例如 amount.scaled(0.015) 为 1.5%。
+     * Для процентных комиссий и начислений: например, amount.scaled(0.015) - это 1.5%.
+     */
+    Money scaled(double factor) const { return fromDouble(toDouble() * factor); }
+
+    constexpr bool isNegative() const { return thousandths < 0; }
+
+    constexpr Money operator-() const { return Money{-thousandths}; }
+    constexpr Money &operator+=(Money other) {
+        thousandths += other.thousandths;
+        return *this;
+    }
+    constexpr Money &operator-=(Money other) {
+        thousandths -= other.thousandths;
+        return *this;
+    }
+    friend constexpr Money operator+(Money lhs, Money rhs) { return Money{lhs.thousandths + rhs.thousandths}; }
+    friend constexpr Money operator-(Money lhs, Money rhs) { return Money{lhs.thousandths - rhs.thousandths}; }
+    friend constexpr bool operator==(Money lhs, Money rhs) { return lhs.thousandths == rhs.thousandths; }
+    friend constexpr bool operator<(Money lhs, Money rhs) { return lhs.thousandths < rhs.thousandths; }
+    friend constexpr bool operator<=(Money lhs, Money rhs) { return lhs.thousandths <= rhs.thousandths; }
+    friend constexpr bool operator>(Money lhs, Money rhs) { return lhs.thousandths > rhs.thousandths; }
+    friend constexpr bool operator>=(Money lhs, Money rhs) { return lhs.thousandths >= rhs.thousandths; }
+};
+
 /**
  * @brief 银行账户结构 / Структура банковского счёта
  * 
  * 题目要求记录账号、类型、余额、币种与活动状态。
  * id: 唯一账号（无符号整数）
- * type: 账户类型（字符串："debit", "deposit", "credit"）
- * balance: 账户资金量（货币单位，double类型，需四舍五入到小数点后3位）
- * currency: 账户货币（字符串："RUB", "YUAN", "USD", "EUR"）
+ * type: 账户类型（加载时由 "debit", "deposit", "credit" 解析为枚举）
+ * balance: 账户资金量（货币单位，定点 Money，精确到小数点后3位）
+ * currency: 账户货币（加载时由 "RUB", "YUAN", "USD", "EUR" 解析为枚举）
  * active: 账户是否处于活动状态（true表示账户有效，false表示已关闭）
  * 
  * Требование задачи: запись номера счёта, типа, баланса, валюты и статуса активности.
  * id: уникальный номер счёта (беззнаковое целое)
- * type: тип счёта (строка: "debit", "deposit", "credit")
- * balance: сумма средств на счёте (денежная единица, тип double, округление до 3 знаков)
- * currency: валюта счёта (строка: "RUB", "YUAN", "USD", "EUR")
+ * type: тип счёта (при загрузке разбирается из "debit", "deposit", "credit" в перечисление)
+ * balance: сумма средств на счёте (денежная единица, Money с фиксированной точкой, 3 знака)
+ * currency: валюта счёта (при загрузке разбирается из "RUB", "YUAN", "USD", "EUR" в перечисление)
  * active: активен ли счёт (true - счёт действителен, false - закрыт)
  */
 struct Account {
     unsigned long long id{};        ///< 唯一账号 / Уникальный номер счёта
-    std::string type;               ///< 账户类型 / Тип счёта
-    double balance{};               ///< 账户余额 / Баланс счёта
-    std::string currency;           ///< 账户货币 / Валюта счёта
+    AccountKind type{AccountKind::Unknown};     ///< 账户类型 / Тип счёта
+    Money balance{};                            ///< 账户余额 / Баланс счёта
+    Currency currency{Currency::Unknown};       ///< 账户货币 / Валюта счёта
     bool active{true};              ///< 是否活动 / Активен ли счёт
 };
 
@@ -200,27 +310,27 @@ struct Deposit {
 struct Loan {
     unsigned long long id{};    ///< 唯一贷款编号 / Уникальный номер кредита
     double rate{};              ///< 利率 / Процентная ставка
-    double amount{};            ///< 贷款金额 / Сумма кредита
+    Money amount{};             ///< 贷款金额 / Сумма кредита
     std::string type;           ///< 贷款类型 / Тип кредита
 };
 
 /**
  * @brief 客户结构 / Структура клиента
  * 
- * 客户数据：包含唯一编号、姓名/组织名以及客户分类字符串。
+ * 客户数据：包含唯一编号、姓名/组织名以及客户分类。
  * id: 客户唯一编号
  * name: 姓名父名/组织名称（字符串，最多99个字符）
- * type: 客户类型（字符串："Individual Client", "VIP Individual Client" 等）
+ * type: 客户类型（加载时由 "Individual Client", "VIP Individual Client" 等解析为枚举）
  * 
- * Данные клиента: уникальный номер, имя/название организации и строка классификации.
+ * Данные клиента: уникальный номер, имя/название организации и классификация.
  * id: уникальный номер клиента
  * name: имя отчество/название организации (строка, максимум 99 символов)
- * type: тип клиента (строка: "Individual Client", "VIP Individual Client" и т.д.)
+ * type: тип клиента (при загрузке разбирается из "Individual Client", "VIP Individual Client" и т.д.)
  */
 struct Client {
     unsigned long long id{};    ///< 客户唯一编号 / Уникальный номер клиента
     std::string name;           ///< 姓名/组织名 / Имя/название организации
-    std::string type;           ///< 客户类型 / Тип клиента
+    CustomerKind type{CustomerKind::NotClient};     ///< 客户类型 / Тип клиента
 };
 
 /**
@@ -281,14 +391,14 @@ struct ClientDebt {
 /**
  * @brief 工作岗位定义结构 / Структура определения рабочего места
  * 
- * type: 工作岗位类型（字符串："Client Manager", "Cash Desk" 等）
+ * type: 工作岗位类型（加载时由 "Client Manager", "Cash Desk" 等解析为枚举）
  * count: 分行中该岗位数量
  * 
- * type: тип рабочего места (строка: "Client Manager", "Cash Desk" и т.д.)
+ * type: тип рабочего места (при загрузке разбирается из "Client Manager", "Cash Desk" и т.д.)
  * count: количество рабочих мест данного типа в отделении
  */
 struct WorkplaceDefinition {
-    std::string type;                   ///< 岗位类型 / Тип рабочего места
+    WorkplaceKind type{WorkplaceKind::Unknown};     ///< 岗位类型 / Тип рабочего места
     unsigned long long count{};         ///< 数量 / Количество
 };
 
@@ -306,45 +416,9 @@ struct WorkplaceDefinition {
  * ratio: коэффициент обмена (отношение покупаемой валюты к продаваемой)
  */
 struct ExchangeRate {
-    std::string fromCurrency;   ///< 出售货币 / Продаваемая валюта
-    std::string toCurrency;     ///< 购买货币 / Покупаемая валюта
-    double ratio{};             ///< 兑换系数 / Коэффициент обмена
-};
-
-/**
- * @brief 货币金额工具结构 / Вспомогательная структура для денежных сумм
- * 
- * Money 结构只是一个工具壳，用于集中处理题目要求的"三位小数四舍五入"逻辑。
- * 题目要求的四舍五入公式：(((long long int)(x * 10000) + 5 * (x < 0.0 ? -1 : 1)) / 10) / 1000.0
- * 示例：round(999999.0004) == 999999.000; round(-999999.0005) == -999999.001
- * 
- * Структура Money - это инструментальная оболочка для централизованной обработки
- * логики "округления до трёх знаков после запятой", требуемой задачей.
- * Формула округления из задачи: (((long long int)(x * 10000) + 5 * (x < 0.0 ? -1 : 1)) / 10) / 1000.0
- * Примеры: round(999999.0004) == 999999.000; round(-999999.0005) == -999999.001
- */
-struct Money {
-    double value{};     ///< 金额值 / Значение суммы
-
-    /**
-     * @brief 四舍五入到小数点后3位 / Округление до 3 знаков после запятой
-     * 
-     * @param x 待四舍五入的数值 / Значение для округления
-     * @return 四舍五入后的结果 / Результат округления
-     */
-    static double round3(double x) {
-        const auto sign = x < 0.0 ? -1.0 : 1.0;
-        long long scaled = static_cast<long long>(x * 10000.0 + 5.0 * sign);
-        return static_cast<double>(scaled / 10) / 1000.0;
-    }
-
-    /**
-     * @brief 规范化金额值 / Нормализация значения суммы
-     * 
-     * 将 value 四舍五入到小数点后3位。
-     * Округляет value до 3 знаков после запятой.
-     */
-    void normalize() { value = round3(value); }
+    Currency fromCurrency{Currency::Unknown};   ///< 出售货币 / Продаваемая валюта
+    Currency toCurrency{Currency::Unknown};     ///< 购买货币 / Покупаемая валюта
+    double ratio{};                             ///< 兑换系数 / Коэффициент обмена
 };
 
 /**
@@ -354,6 +428,7 @@ struct Money {
  * @return 对应的货币枚举值 / Соответствующее значение перечисления валют
  */
 inline Currency parseCurrency(std::string_view text) {
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
     if (text == "RUB") return Currency::RUB;
     if (text == "YUAN") return Currency::YUAN;
     if (text == "USD") return Currency::USD;
@@ -380,6 +455,91 @@ inline const char *toString(Currency c) {
     }
 }
 
+/**
+ * @brief 货币在平坦数组中的下标 / Индекс валюты в плоском массиве
+ * 
+ * RUB -> 0, YUAN -> 1, USD -> 2, EUR -> 3，未知货币返回 -1。
+ * RUB -> 0, YUAN -> 1, USD -> 2, EUR -> 3, для неизвестной валюты -1.
+ */
+constexpr int currencyIndex(Currency c) {
+    return c == Currency::Unknown ? -1 : static_cast<int>(c);
+}
+
+/**
+ * @brief 稠密汇率矩阵 / Плотная матрица курсов
+ *
+ * rates[出售][购买] = 兑换系数，0 表示无法兑换。
+ * rates[продаваемая][покупаемая] = коэффициент, 0 - обмен невозможен.
+ */
+using RateMatrix = std::array<std::array<double, kCurrencyCount>, kCurrencyCount>;
+
+/**
+ * @brief 由报价构建完整汇率矩阵 / Построение полной матрицы курсов по котировкам
+ *
+ * 直接报价优先；缺少的方向取反向报价的倒数；仍缺少的币种对
+ * 经由中间货币求交叉汇率（传递闭包，每对取第一条找到的路径）。
+ * Прямые котировки в приоритете; недостающее направление - обратная величина встречной
+ * котировки; оставшиеся пары - кросс-курс через промежуточную валюту (транзитивное
+ * замыкание, для пары берётся первый найденный путь).
+ *
+ * @param quotes 输入文件中的汇率 / Курсы из входного файла
+ * @return 汇率矩阵 / Матрица курсов
+ */
+inline RateMatrix buildRateMatrix(const std::vector<ExchangeRate> &quotes) {
+    RateMatrix rates{};
+    for (std::size_t c = 0; c < kCurrencyCount; ++c) rates[c][c] = 1.0;
+    for (const auto &quote : quotes) {
+        const int from = currencyIndex(quote.fromCurrency);
+        const int to = currencyIndex(quote.toCurrency);
+        if (from < 0 || to < 0 || from == to || !(quote.ratio > 0.0)) continue;
+        rates[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] = quote.ratio;
+    }
+    for (std::size_t i = 0; i < kCurrencyCount; ++i) {
+        for (std::size_t j = 0; j < kCurrencyCount; ++j) {
+            if (rates[i][j] == 0.0 && rates[j][i] > 0.0) rates[i][j] = 1.0 / rates[j][i];
+        }
+    }
+    for (std::size_t k = 0; k < kCurrencyCount; ++k) {
+        for (std::size_t i = 0; i < kCurrencyCount; ++i) {
+            if (rates[i][k] == 0.0) continue;
+            for (std::size_t j = 0; j < kCurrencyCount; ++j) {
+                if (rates[i][j] == 0.0 && rates[k][j] > 0.0) rates[i][j] = rates[i][k] * rates[k][j];
+            }
+        }
+    }
+    return rates;
+}
+
+/**
+ * @brief 解析账户类型 / Парсинг типа счёта
+ * 
+ * 类型字段后面紧跟 " # "，按 scanf 语义读入时会带尾随空格（"deposit "），这里忽略。
+ * За полем типа сразу идёт " # ", поэтому по семантике scanf оно читается с хвостовым
+ * пробелом ("deposit "); здесь он игнорируется.
+ * 
+ * @param text 账户类型字符串（"debit", "deposit", "credit"）/ Строка типа счёта
+ * @return 对应的账户类型枚举值 / Соответствующее значение перечисления типа счёта
+ */
+inline AccountKind parseAccountKind(std::string_view text) {
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    if (text == "debit") return AccountKind::Debit;
+    if (text == "deposit") return AccountKind::Deposit;
+    if (text == "credit") return AccountKind::Credit;
+    return AccountKind::Unknown;
+}
+
+/**
+ * @brief 将账户类型枚举转换为字符串 / Преобразование перечисления типа счёта в строку
+ */
+inline const char *toString(AccountKind kind) {
+    switch (kind) {
+        case AccountKind::Debit: return "debit";
+        case AccountKind::Deposit: return "deposit";
+        case AccountKind::Credit: return "credit";
+        default: return "unknown";
+    }
+}
+
 /**
  * @brief 将完整的客户类型描述解析为枚举 / Парсинг полного описания типа клиента в перечисление
  * 
@@ -435,26 +595,151 @@ inline const char *toString(CustomerKind kind) {
  * @param kind 客户类型枚举值 / Значение перечисления типа клиента
  * @return true 如果是VIP客户 / true если VIP-клиент
  */
-inline bool isVip(CustomerKind kind) {
+constexpr bool isVip(CustomerKind kind) {
     return kind == CustomerKind::VipIndividual || kind == CustomerKind::VipLegal;
 }
 
+/**
+ * @brief 客户类型在平坦数组中的下标 / Индекс типа клиента в плоском массиве
+ * 
+ * Individual -> 0, VipIndividual -> 1, Legal -> 2, VipLegal -> 3，非客户返回 -1。
+ * Individual -> 0, VipIndividual -> 1, Legal -> 2, VipLegal -> 3, для не клиента -1.
+ */
+constexpr int customerIndex(CustomerKind kind) {
+    return kind == CustomerKind::NotClient ? -1 : static_cast<int>(kind);
+}
+
+/**
+ * @brief 解析工作岗位类型 / Парсинг типа рабочего места
+ * 
+ * 与账户类型相同，字段后紧跟 " # "，忽略尾随空格。
+ * Как и у типа счёта, за полем идёт " # ", поэтому хвостовые пробелы игнорируются.
+ */
+inline WorkplaceKind parseWorkplaceKind(std::string_view text) {
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    if (text == "Client Manager") return WorkplaceKind::ClientManager;
+    if (text == "Cash Desk") return WorkplaceKind::CashDesk;
+    if (text == "Currency Exchange") return WorkplaceKind::CurrencyExchange;
+    if (text == "VIP Client Manager") return WorkplaceKind::VipManager;
+    return WorkplaceKind::Unknown;
+}
+
+/**
+ * @brief 将工作岗位类型转换为字符串 / Преобразование типа рабочего места в строку
+ */
+inline const char *toString(WorkplaceKind kind) {
+    switch (kind) {
+        case WorkplaceKind::ClientManager: return "Client Manager";
+        case WorkplaceKind::CashDesk: return "Cash Desk";
+        case WorkplaceKind::CurrencyExchange: return "Currency Exchange";
+        case WorkplaceKind::VipManager: return "VIP Client Manager";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief 新客户注册耗时（分钟）/ Длительность регистрации нового клиента (минуты)
+ * 
+ * 注册只在"客户服务窗口"办理。/ Регистрация выполняется только в "Client Manager".
+ */
+constexpr unsigned kRegistrationMinutes = 15;
+
+/**
+ * @brief 操作耗时（分钟）/ Длительность операции (минуты)
+ */
+constexpr unsigned serviceMinutes(Operation op) {
+    switch (op) {
+        case Operation::BalanceInquiry: return 5;
+        case Operation::CreateAccount: return 10;
+        case Operation::CloseAccount: return 25;
+        case Operation::WithdrawFunds: return 10;
+        case Operation::TopUpFunds: return 5;
+        case Operation::CurrencyExchange: return 10;
+        case Operation::RequestDebitCard: return 10;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief 办理操作的工作岗位 / Рабочее место для операции
+ * 
+ * 按题目"工作岗位执行的操作"表：现金业务在现金柜台，兑换在货币兑换点，
+ * 其余业务 VIP 客户在优先客户经理、普通客户在客户服务窗口办理。
+ * 
+ * По таблице задачи: кассовые операции - "Cash Desk", обмен - "Currency Exchange",
+ * остальное - "VIP Client Manager" для VIP-клиентов и "Client Manager" для прочих.
+ */
+constexpr WorkplaceKind workplaceFor(Operation op, CustomerKind kind) {
+    switch (op) {
+        case Operation::WithdrawFunds:
+        case Operation::TopUpFunds:
+            return WorkplaceKind::CashDesk;
+        case Operation::CurrencyExchange:
+            return WorkplaceKind::CurrencyExchange;
+        case Operation::Unknown:
+            return WorkplaceKind::Unknown;
+        default:
+            return isVip(kind) ? WorkplaceKind::VipManager : WorkplaceKind::ClientManager;
+    }
+}
+
+/**
+ * @brief 按行首前缀识别操作 / Распознавание операции по префиксу строки
+ * 
+ * @param line 操作行（例如 "Balance Inquiry # 42"）/ Строка операции (например "Balance Inquiry # 42")
+ * @return 对应的操作枚举值 / Соответствующее значение перечисления операций
+ */
+inline Operation parseOperation(std::string_view line) {
+    static constexpr std::pair<std::string_view, Operation> kPrefixes[] = {
+        {"Balance Inquiry", Operation::BalanceInquiry},
+        {"Create Account", Operation::CreateAccount},
+        {"Close Account", Operation::CloseAccount},
+        {"Withdraw Funds", Operation::WithdrawFunds},
+        {"Top-up Founds", Operation::TopUpFunds},
+        {"Currency Exchange", Operation::CurrencyExchange},
+        {"Request Debit Card", Operation::RequestDebitCard},
+    };
+    for (const auto &[prefix, op] : kPrefixes) {
+        if (line.substr(0, prefix.size()) == prefix) return op;
+    }
+    return Operation::Unknown;
+}
+
+/**
+ * @brief 将操作枚举转换为输入中的名称 / Преобразование операции в её имя во вводе
+ *
+ * @param op 操作枚举值 / Значение перечисления операций
+ * @return 与 parseOperation 前缀一致的名称 / Имя, совпадающее с префиксом parseOperation
+ */
+inline const char *toString(Operation op) {
+    switch (op) {
+        case Operation::BalanceInquiry: return "Balance Inquiry";
+        case Operation::CreateAccount: return "Create Account";
+        case Operation::CloseAccount: return "Close Account";
+        case Operation::WithdrawFunds: return "Withdraw Funds";
+        case Operation::TopUpFunds: return "Top-up Founds";
+        case Operation::CurrencyExchange: return "Currency Exchange";
+        case Operation::RequestDebitCard: return "Request Debit Card";
+        case Operation::Unknown: default: return "Unknown";
+    }
+}
+
 /**
  * @brief 解析金额的整数部分和小数部分 / Парсинг целой и дробной частей суммы
  * 
- * 题目给定金额格式：整数部分与三位小数分开提供，这里进行组合并四舍五入。
+ * 题目给定金额格式：整数部分与三位小数分开提供，这里直接组合为千分位整数，无需舍入。
  * 例如：major=1999, minor=999 -> 1999.999
  * 
  * Формат суммы из задачи: целая часть и три знака после запятой предоставляются отдельно,
- * здесь они объединяются и округляются.
+ * здесь они сразу объединяются в целое число тысячных, округление не требуется.
  * Например: major=1999, minor=999 -> 1999.999
  * 
  * @param major 整数部分 / Целая часть
  * @param minor 小数部分（0-999）/ Дробная часть (0-999)
- * @return 组合后的金额值（已四舍五入到3位小数）/ Объединённое значение суммы (округлено до 3 знаков)
+ * @return 组合后的金额 / Объединённая сумма
  */
-inline double parseMoneyParts(unsigned long long major, unsigned long long minor) {
-    return Money::round3(static_cast<double>(major) + static_cast<double>(minor) / 1000.0);
+constexpr Money parseMoneyParts(unsigned long long major, unsigned long long minor) {
+    return Money::fromThousandths(static_cast<std::int64_t>(major * Money::kScale + minor));
 }
 
 /**
@@ -472,29 +757,49 @@ struct MoneyFormat {
 /**
  * @brief 格式化金额用于输出 / Форматирование суммы для вывода
  * 
- * 输出前统一格式化金额，保留符号与 3 位小数。
- * 将 double 类型的金额转换为 MoneyFormat 结构，便于使用 printf 输出。
- * 
- * Единое форматирование суммы перед выводом, сохранение знака и 3 знаков после запятой.
- * Преобразование суммы типа double в структуру MoneyFormat для удобного вывода через printf.
+ * 输出前统一格式化金额，保留符号与 3 位小数；全部为整数运算。
+ * Единое форматирование суммы перед выводом, сохранение знака и 3 знаков после запятой;
+ * только целочисленные операции.
  * 
  * @param amount 待格式化的金额 / Сумма для форматирования
  * @return 格式化后的结构 / Отформатированная структура
  */
-inline MoneyFormat formatMoney(double amount) {
+constexpr MoneyFormat formatMoney(Money amount) {
     MoneyFormat fmt{};
-    fmt.negative = amount < 0.0;
-    double absValue = fmt.negative ? -amount : amount;
-    absValue = Money::round3(absValue);
-    fmt.major = static_cast<unsigned long long>(std::floor(absValue + 1e-9));
-    double fraction = absValue - static_cast<double>(fmt.major);
-    fmt.minor = static_cast<unsigned long long>(std::llround(fraction * 1000.0));
-    if (fmt.minor >= 1000) {
-        fmt.major += 1;
-        fmt.minor -= 1000;
-    }
+    fmt.negative = amount.isNegative();
+    const auto absValue = static_cast<unsigned long long>(fmt.negative ? -amount.thousandths : amount.thousandths);
+    fmt.major = absValue / Money::kScale;
+    fmt.minor = absValue % Money::kScale;
     return fmt;
 }
 
-}  // namespace domain
+/**
+ * @brief 快速写出金额文本 / Быстрая запись суммы в текст
+ * 
+ * 以 "[-]major.mmm" 形式写入 out，返回写入结束位置（不追加 '\0'）。
+ * out 至少需要 kMaxMoneyText 字节。
+ * 
+ * Записывает сумму в out в виде "[-]major.mmm" и возвращает конец записи (без '\0').
+ * out должен вмещать не менее kMaxMoneyText байт.
+ */
+constexpr std::size_t kMaxMoneyText = 32;
+
+inline char *writeMoney(char *out, Money amount) {
+    const auto fmt = formatMoney(amount);
+    if (fmt.negative) *out++ = '-';
+    char digits[24];
+    std::size_t n = 0;
+    auto major = fmt.major;
+    do {
+        digits[n++] = static_cast<char>('0' + major % 10);
+        major /= 10;
+    } while (major != 0);
+    while (n > 0) *out++ = digits[--n];
+    *out++ = '.';
+    out[0] = static_cast<char>('0' + fmt.minor / 100);
+    out[1] = static_cast<char>('0' + fmt.minor / 10 % 10);
+    out[2] = static_cast<char>('0' + fmt.minor % 10);
+    return out + 3;
+}
 
+}  // namespace domain
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file Generator.hpp
+ * @brief 分行输入文件生成器 / Генератор входных файлов отделения
+ *
+ * 按题目格式生成完整的分行输入：全部初始数据表，以及 M 个营业日的事件流。
+ * 每个营业日有固定数量的 Personal Appeal，到访时间在 8:00-18:59 之间并按时间排序；
+ * 操作类型按权重抽取，金额、账号与货币都来自已生成的数据，因此大部分操作能真正执行。
+ * 相同的种子总是生成逐字节相同的文件，便于比较不同版本的性能。
+ *
+ * Генерирует полный ввод отделения в формате задачи: все таблицы начальных данных
+ * и поток событий за M банковских дней. В каждый день - фиксированное число
+ * Personal Appeal со временем прихода 8:00-18:59 по возрастанию; тип операции
+ * выбирается по весам, суммы, счета и валюты берутся из уже созданных данных,
+ * поэтому большинство операций действительно выполняется. Одинаковое зерно даёт
+ * побайтно одинаковый файл, что удобно для сравнения производительности версий.
+ */
+
+#include "Domain.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace bank {
+
+/// 各操作类型的权重（按 domain::Operation 下标）/ Веса типов операций (по индексу domain::Operation)
+using OperationMix = std::array<unsigned, domain::kOperationCount>;
+
+/**
+ * @brief 生成参数 / Параметры генерации
+ */
+struct GeneratorConfig {
+    std::size_t clients{1000};              ///< 初始客户数 / Начальное число клиентов
+    std::size_t days{30};                   ///< 营业日数 / Число банковских дней
+    std::size_t appealsPerDay{200};         ///< 每日到访数 / Обращений в день
+    std::size_t maxOperations{5};           ///< 每次到访的最多操作数（0 - 无操作）/ Максимум операций за обращение (0 - без операций)
+    double newClientShare{0.05};            ///< 新客户到访比例 / Доля обращений новых клиентов
+    unsigned long long seed{1};             ///< 随机种子 / Зерно генератора
+    OperationMix mix{6, 1, 1, 3, 3, 2, 1};  ///< 操作权重 / Веса операций
+};
+
+/**
+ * @brief 生成结果 / Результат генерации
+ */
+struct GeneratedInput {
+    std::string text;                                               ///< 输入文件内容 / Содержимое входного файла
+    std::size_t events{0};                                          ///< 事件行数 / Число строк событий
+    std::array<std::size_t, domain::kOperationCount> operations{};  ///< 各类型操作数 / Число операций каждого типа
+};
+
+/**
+ * @brief 解析操作权重 / Разбор весов операций
+ *
+ * 格式："balance=6,create=1,close=1,withdraw=3,topup=3,exchange=2,card=1"，
+ * 未列出的类型权重为 0。
+ * Формат: "balance=6,create=1,..."; неуказанные типы получают вес 0.
+ *
+ * @return 格式是否正确且至少有一个正权重 / Корректен ли формат и есть ли хотя бы один положительный вес
+ */
+bool parseOperationMix(std::string_view text, OperationMix& mix);
+
+/// parseOperationMix 使用的短名称 / Короткое имя для parseOperationMix
+const char* operationKey(domain::Operation op);
+
+/**
+ * @brief 生成分行输入 / Генерация ввода отделения
+ */
+GeneratedInput generateBranchInput(const GeneratorConfig& config);
+
+}  // namespace bank
@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * @file Input.hpp
+ * @brief 输入缓冲与行解析工具 / Буфер ввода и инструменты разбора строк
+ *
+ * 初始数据与事件流一次性映射（mmap）到内存，之后所有解析都直接在
+ * 这块只读缓冲上进行，不再逐行调用 std::scanf / std::fgets。
+ *
+ * Начальные данные и поток событий один раз отображаются (mmap) в память,
+ * после чего весь разбор выполняется прямо по этому буферу без построчных
+ * вызовов std::scanf / std::fgets.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace io {
+
+/**
+ * @brief 映射到内存的输入 / Отображённый в память ввод
+ *
+ * 普通文件通过 mmap 映射；管道、终端或不支持 mmap 的平台则整体读入内存。
+ * Обычные файлы отображаются через mmap; каналы, терминалы и платформы без
+ * mmap целиком считываются в память.
+ */
+class MappedInput {
+public:
+    MappedInput() = default;
+    ~MappedInput();
+
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+    MappedInput(MappedInput&& other) noexcept;
+    MappedInput& operator=(MappedInput&& other) noexcept;
+
+    /**
+     * @brief 打开指定文件 / Открытие указанного файла
+     *
+     * @param path 文件路径，nullptr 表示标准输入 / Путь к файлу, nullptr - стандартный ввод
+     * @return 是否成功 / Успешно ли
+     */
+    bool open(const char* path);
+
+    /// 全部输入内容 / Всё содержимое ввода
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    void release();
+    bool readAll(std::FILE* file);
+
+    const char* data_{nullptr};     ///< 数据起始 / Начало данных
+    std::size_t size_{0};           ///< 数据长度 / Длина данных
+    bool mapped_{false};            ///< 是否为 mmap 映射 / Получены ли данные через mmap
+    std::string fallback_;          ///< 无法映射时的副本 / Копия, если mmap недоступен
+};
+
+/**
+ * @brief 行游标 / Курсор по строкам
+ *
+ * 在缓冲上逐行前进，返回不含 \n/\r 的 string_view，不做任何拷贝。
+ * Продвигается по буферу построчно и возвращает string_view без \n/\r, без копирования.
+ */
+class LineCursor {
+public:
+    LineCursor() = default;
+    explicit LineCursor(std::string_view text) : text_(text) {}
+
+    /**
+     * @brief 读取下一行 / Чтение следующей строки
+     *
+     * @param line 输出：行内容 / Выход: содержимое строки
+     * @return 是否还有行 / Есть ли ещё строки
+     */
+    bool next(std::string_view& line);
+
+    /**
+     * @brief 读取下一条非空行 / Чтение следующей непустой строки
+     *
+     * 与 scanf 格式末尾的 "\n" 一致：跳过只含空白的行。
+     * Как "\n" в конце формата scanf: пропускает строки из одних пробелов.
+     */
+    bool nextNonBlank(std::string_view& line);
+
+    std::size_t offset() const { return pos_; }
+
+    /// 定位到缓冲中的偏移（用于从日志恢复）/ Переход к смещению в буфере (для восстановления из журнала)
+    void seek(std::size_t offset) { pos_ = std::min(offset, text_.size()); }
+    bool atEnd() const { return pos_ >= text_.size(); }
+
+    /// 缓冲中 [from, to) 片段 / Фрагмент буфера [from, to)
+    std::string_view slice(std::size_t from, std::size_t to) const { return text_.substr(from, to - from); }
+
+private:
+    std::string_view text_;
+    std::size_t pos_{0};
+};
+
+/**
+ * @brief 初始数据表片段 / Фрагмент таблицы начальных данных
+ *
+ * 表头之后的 count 行原始文本，供各 readXxx 独立（并行）解析。
+ * Сырой текст count строк после заголовка для независимого (параллельного) разбора в readXxx.
+ */
+struct Section {
+    std::string_view header;        ///< 表头名称 / Имя заголовка
+    unsigned long long count{};     ///< 记录数 / Количество записей
+    std::string_view body;          ///< 记录文本 / Текст записей
+};
+
+/**
+ * @brief 定位一个数据表的边界 / Определение границ таблицы данных
+ *
+ * 读取 "<header> %llu" 表头，然后跳过 count 条非空行。
+ * Читает заголовок "<header> %llu", затем пропускает count непустых строк.
+ *
+ * @return 是否成功 / Успешно ли
+ */
+bool locateSection(LineCursor& cursor, std::string_view header, Section& section);
+
+/**
+ * @brief 单行字段读取器 / Чтение полей одной строки
+ *
+ * 按题目给出的 scanf 格式语义解析字段：" # " 分隔符两侧可有空白，
+ * 字符串字段对应 "%99[a-zA-Z0-9/_ ]"（保留尾随空格，与 scanf 一致）。
+ *
+ * Разбирает поля с семантикой форматов scanf из задачи: вокруг " # " допускаются
+ * пробелы, строковые поля соответствуют "%99[a-zA-Z0-9/_ ]" (хвостовые пробелы
+ * сохраняются, как у scanf).
+ */
+class FieldReader {
+public:
+    explicit FieldReader(std::string_view line) : line_(line) {}
+
+    bool readUnsigned(unsigned long long& value);
+    bool readDouble(double& value);
+    bool readMoney(unsigned long long& major, unsigned long long& minor);
+    bool readText(std::string_view& value);
+
+    /// 分隔符 " # "（两侧空白均跳过）/ Разделитель " # " (пробелы с обеих сторон пропускаются)
+    bool separator();
+
+    /// 跳过空白后匹配单个字符 / Пропуск пробелов и сопоставление одного символа
+    bool literal(char c);
+
+    /// 跳过空白（scanf 格式中的空格）/ Пропуск пробелов (пробел в формате scanf)
+    void skipSpaces();
+
+private:
+
+    std::string_view line_;
+    std::size_t pos_{0};
+};
+
+}  // namespace io
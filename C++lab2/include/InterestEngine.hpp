@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file InterestEngine.hpp
+ * @brief 期末计息与到期引擎 / Движок начисления процентов и сроков депозитов
+ *
+ * 存款与贷款按计息周期分成"账本"，每个账本按列存放（账号、周期利率、本金、
+ * 起止日期……）。计息分三步：银行把余额收集到连续数组，引擎在无分支的循环里
+ * 批量算出利息，银行再按产品编号顺序一次性过账。
+ *
+ * Депозиты и кредиты разложены по периодам начисления в "книги", каждая хранится
+ * по столбцам (счёт, ставка за период, сумма кредита, даты начала и окончания...).
+ * Начисление - три шага: банк собирает остатки в непрерывный массив, движок
+ * считает проценты пакетом в цикле без ветвлений, затем банк проводит их
+ * одним проходом в порядке номеров продуктов.
+ */
+
+#include "Domain.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace bank {
+
+/// 计息周期 / Период начисления
+enum class AccrualPeriod : std::uint8_t { Daily, Monthly, Quarterly, SemiAnnual, Annual };
+
+inline constexpr std::size_t kAccrualPeriodCount = 5;
+
+/// 一年中的周期数：年利率按此折算 / Число периодов в году для пересчёта годовой ставки
+constexpr double periodsPerYear(AccrualPeriod period) {
+    switch (period) {
+        case AccrualPeriod::Daily: return 365.0;
+        case AccrualPeriod::Monthly: return 12.0;
+        case AccrualPeriod::Quarterly: return 4.0;
+        case AccrualPeriod::SemiAnnual: return 2.0;
+        case AccrualPeriod::Annual: return 1.0;
+    }
+    return 1.0;
+}
+
+/**
+ * @brief 产品类型解析结果 / Результат разбора типа продукта
+ */
+struct AccrualTerms {
+    bool valid{false};                              ///< 类型是否可识别 / Распознан ли тип
+    AccrualPeriod period{AccrualPeriod::Daily};     ///< 计息周期 / Период
+    bool minimum{false};                            ///< 按期内最低余额 / По минимальному остатку
+};
+
+/// "Compounded <周期> Remaining|Min" / "Compounded <период> Remaining|Min"
+AccrualTerms parseDepositTerms(std::string_view type);
+
+/// "Charged <周期>" / "Charged <период>"
+AccrualTerms parseLoanTerms(std::string_view type);
+
+/**
+ * @brief 计息引擎 / Движок начисления процентов
+ */
+class InterestEngine {
+public:
+    /// 无固定期限的存款 / Депозит без срока
+    static constexpr unsigned long long kOpenEnded = std::numeric_limits<unsigned long long>::max();
+
+    /**
+     * @brief 一个周期的产品账本（按列存放）/ Книга продуктов одного периода (по столбцам)
+     *
+     * base 由银行在计息前填入（存款：余额或期内最低余额；贷款：余额），
+     * interest 由 compute* 写出，单位均为千分位。
+     * base заполняет банк перед начислением (депозит: остаток или минимум за период;
+     * кредит: остаток), interest пишут compute*; всё в тысячных долях.
+     */
+    struct Book {
+        std::vector<unsigned long long> productId;  ///< 存款/贷款编号 / Номер депозита/кредита
+        std::vector<unsigned long long> account;    ///< 关联账号 / Связанный счёт
+        std::vector<double> rate;                   ///< 周期利率（小数）/ Ставка за период (доля)
+        std::vector<std::int64_t> principal;        ///< 贷款金额 / Сумма кредита
+        std::vector<unsigned long long> opensOn;    ///< 起息日 / Первый день начисления
+        std::vector<unsigned long long> maturesOn;  ///< 到期日（不再计息）/ День окончания (без начисления)
+        std::vector<std::uint8_t> minimum;          ///< 按最低余额 / По минимальному остатку
+        std::vector<std::int64_t> base;             ///< 计息基数 / База начисления
+        std::vector<std::int64_t> interest;         ///< 本期利息 / Проценты за период
+
+        std::size_t size() const { return account.size(); }
+    };
+
+    /// 清空所有账本 / Очистка всех книг
+    void clear();
+
+    /// 登记存款；类型无法识别或利率非正时忽略 / Регистрация депозита; неизвестный тип или ставка <= 0 игнорируются
+    void addDeposit(unsigned long long accountId, const domain::Deposit& deposit);
+
+    /// 登记贷款 / Регистрация кредита
+    void addLoan(unsigned long long accountId, const domain::Loan& loan);
+
+    /// 按产品编号排序，使过账顺序确定 / Сортировка по номерам продуктов для детерминированного порядка проводок
+    void finalize();
+
+    Book& deposits(AccrualPeriod period) { return deposits_[static_cast<std::size_t>(period)]; }
+    Book& loans(AccrualPeriod period) { return loans_[static_cast<std::size_t>(period)]; }
+
+    /**
+     * @brief 移除已到期的存款 / Удаление депозитов с истёкшим сроком
+     *
+     * 只在有存款到期时才压缩账本，并保持剩余产品的顺序。
+     * Книги сжимаются только когда срок действительно истёк; порядок остальных сохраняется.
+     */
+    void retireMatured(unsigned long long day);
+
+    /// 存款利息：base * rate，仅在 [opensOn, maturesOn) 内 / Проценты по депозиту: base * rate в [opensOn, maturesOn)
+    static void computeDeposits(Book& book, unsigned long long day);
+
+    /// 贷款利息：(principal - base) * rate / Проценты по кредиту: (principal - base) * rate
+    static void computeLoans(Book& book);
+
+private:
+    static void reorder(Book& book);
+
+    std::array<Book, kAccrualPeriodCount> deposits_{};
+    std::array<Book, kAccrualPeriodCount> loans_{};
+    unsigned long long nextMaturity_{kOpenEnded};
+};
+
+}  // namespace bank
@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file Journal.hpp
+ * @brief 预写日志与快照的二进制格式 / Двоичный формат журнала предзаписи и снимков
+ *
+ * 日志只追加：每次余额变动、新开账户、销户、新客户注册各写一条定长（客户姓名除外）记录，
+ * 营业日结束时写入 EndOfDay 标记并一次性 fsync。重启时只采用最后一个 EndOfDay
+ * 之前的记录，之后不完整的尾部被截掉。
+ * 快照是账户、客户与客户账户关系的完整副本，先写临时文件再改名，保证原子替换；
+ * 快照写成后日志清空。
+ *
+ * Журнал только дописывается: на каждое изменение остатка, открытие и закрытие
+ * счёта и регистрацию клиента - одна запись фиксированной длины (кроме имени клиента);
+ * в конце банковского дня пишется метка EndOfDay и выполняется один fsync.
+ * При перезапуске учитываются только записи до последней EndOfDay, неполный
+ * хвост отрезается. Снимок - полная копия счетов, клиентов и связей клиент-счёт;
+ * пишется во временный файл и переименовывается, поэтому замена атомарна;
+ * после записи снимка журнал очищается.
+ */
+
+#include "Domain.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace bank {
+
+/// 日志记录类型 / Тип записи журнала
+enum class JournalRecordType : std::uint8_t {
+    Balance = 1,        ///< 余额变动 / Изменение остатка
+    OpenAccount = 2,    ///< 新开账户 / Открытие счёта
+    NewClient = 3,      ///< 新客户 / Новый клиент
+    EndOfDay = 4,       ///< 营业日提交点 / Точка фиксации дня
+    CloseAccount = 5,   ///< 销户 / Закрытие счёта
+};
+
+/**
+ * @brief 解码后的日志记录 / Декодированная запись журнала
+ *
+ * 各字段按类型使用 / Поля используются в зависимости от типа:
+ * Balance: id=账号, amount=变动；OpenAccount: id=账号, other=客户, amount=初始余额,
+ * currency, kind=账户类型；NewClient: id=客户, kind=客户类型, name；
+ * EndOfDay: id=营业日, other=输入偏移；CloseAccount: id=账号。
+ */
+struct JournalRecord {
+    JournalRecordType type{JournalRecordType::Balance};
+    unsigned long long id{};
+    unsigned long long other{};
+    domain::Money amount{};
+    std::uint8_t currency{};
+    std::uint8_t kind{};
+    std::string name;
+};
+
+/**
+ * @brief 追加二进制字段的缓冲 / Буфер для дописывания двоичных полей
+ */
+class BinaryWriter {
+public:
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto offset = data_.size();
+        data_.resize(offset + sizeof(T));
+        std::memcpy(data_.data() + offset, &value, sizeof(T));
+    }
+
+    /// 长度（uint16）+ 字节 / Длина (uint16) + байты
+    void putText(std::string_view text);
+
+    const std::string& data() const { return data_; }
+    std::string& data() { return data_; }
+    void clear() { data_.clear(); }
+
+private:
+    std::string data_;
+};
+
+/**
+ * @brief 带越界检查的读取器 / Читатель с проверкой границ
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(std::string_view data) : data_(data) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data_.size() - pos_ < sizeof(T)) return false;
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool getText(std::string& text);
+
+    /// 跳过 size 字节 / Пропуск size байт
+    bool skip(std::size_t size) {
+        if (data_.size() - pos_ < size) return false;
+        pos_ += size;
+        return true;
+    }
+
+    std::size_t offset() const { return pos_; }
+    bool atEnd() const { return pos_ >= data_.size(); }
+
+private:
+    std::string_view data_;
+    std::size_t pos_{0};
+};
+
+/**
+ * @brief 预写日志 / Журнал предзаписи
+ */
+class Journal {
+public:
+    Journal() = default;
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * @brief 以追加方式打开日志 / Открытие журнала на дозапись
+     *
+     * @param validBytes 保留的已提交前缀长度，之后的尾部被截掉 / Длина зафиксированного префикса, хвост отрезается
+     */
+    bool open(const std::string& path, std::size_t validBytes);
+
+    bool active() const { return file_ != nullptr; }
+
+    void balance(unsigned long long accountId, domain::Money delta);
+    void openAccount(unsigned long long accountId,
+                     unsigned long long clientId,
+                     domain::Currency currency,
+                     domain::AccountKind kind,
+                     domain::Money balance);
+    void newClient(unsigned long long clientId, domain::CustomerKind kind, std::string_view name);
+    void closeAccount(unsigned long long accountId);
+
+    /**
+     * @brief 写入营业日提交点并落盘 / Запись точки фиксации дня и сброс на диск
+     *
+     * 当天积累的记录一次写出、一次 fsync。
+     * Записи за день пишутся одним блоком с одним fsync.
+     *
+     * @param inputOffset 下一个待处理事件在输入中的偏移 / Смещение следующего события во вводе
+     */
+    bool commitDay(unsigned long long day, std::size_t inputOffset);
+
+    /// 快照写成后清空日志 / Очистка журнала после записи снимка
+    bool truncate();
+
+    void close();
+
+private:
+    std::FILE* file_{nullptr};
+    std::string path_;
+    BinaryWriter pending_;
+};
+
+/**
+ * @brief 读取日志中已提交的部分 / Чтение зафиксированной части журнала
+ *
+ * @param records 输出：最后一个 EndOfDay 及之前的记录 / Выход: записи до последней EndOfDay включительно
+ * @param validBytes 输出：已提交前缀的字节数 / Выход: длина зафиксированного префикса в байтах
+ * @return 文件能否读取（不存在视为空日志）/ Удалось ли прочитать (отсутствие файла - пустой журнал)
+ */
+bool readJournal(const std::string& path, std::vector<JournalRecord>& records, std::size_t& validBytes);
+
+/// 原子写入整个文件（临时文件 + fsync + 改名）/ Атомарная запись файла (временный файл + fsync + переименование)
+bool writeFileAtomically(const std::string& path, const std::string& data);
+
+/// 读取整个文件；不存在时返回 false / Чтение файла целиком; false, если его нет
+bool readWholeFile(const std::string& path, std::string& data);
+
+}  // namespace bank
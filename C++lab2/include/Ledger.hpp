@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file Ledger.hpp
+ * @brief 复式记账的过账批次与二进制账簿 / Пакеты проводок двойной записи и двоичная книга
+ *
+ * 资金流动不再逐笔修改余额再写日志，而是先登记为一批 (from, to, amount) 分录，
+ * 由银行一次遍历完成校验与过账。现金（分行之外）用账号 kCash 表示，
+ * 因此充值是 kCash -> 账户，取款是 账户 -> kCash。
+ * 账簿打开时，每笔已过账分录另写一条定长二进制记录（30 字节），营业日结束时追加到文件。
+ *
+ * Движения денег больше не меняют остатки по одному с записью в журнал: сначала
+ * они набираются в пакет проводок (from, to, amount), затем банк проверяет и
+ * проводит пакет за один проход. Наличные (вне отделения) - номер kCash, поэтому
+ * пополнение - kCash -> счёт, снятие - счёт -> kCash. Если книга открыта, каждая
+ * проведённая проводка пишется фиксированной двоичной записью (30 байт), которые
+ * дописываются в файл в конце банковского дня.
+ */
+
+#include "Domain.hpp"
+#include "Journal.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bank {
+
+/// 分录 / Проводка
+struct Posting {
+    unsigned long long from{};      ///< 借方账号（kCash 为现金）/ Счёт списания (kCash - наличные)
+    unsigned long long to{};        ///< 贷方账号（kCash 为现金）/ Счёт зачисления (kCash - наличные)
+    domain::Money amount{};         ///< 金额 / Сумма
+    bool checked{true};             ///< 借方余额必须足够 / Остаток счёта списания должен покрывать сумму
+};
+
+/// 账簿中的一条记录 / Запись двоичной книги
+struct LedgerRecord {
+    std::uint32_t day{};
+    std::uint16_t minuteOfDay{};
+    unsigned long long from{};
+    unsigned long long to{};
+    domain::Money amount{};
+};
+
+/**
+ * @brief 过账批次与二进制账簿 / Пакет проводок и двоичная книга
+ */
+class Ledger {
+public:
+    /// 现金：分行之外的对手方 / Наличные: контрагент вне отделения
+    static constexpr unsigned long long kCash = 0;
+
+    Ledger() = default;
+    ~Ledger();
+
+    Ledger(const Ledger&) = delete;
+    Ledger& operator=(const Ledger&) = delete;
+
+    /// 登记一笔分录；金额为零的分录忽略 / Добавление проводки; нулевые суммы игнорируются
+    void add(unsigned long long from, unsigned long long to, domain::Money amount, bool checked = true) {
+        if (amount == domain::Money{}) return;
+        batch_.push_back({from, to, amount, checked});
+    }
+
+    const std::vector<Posting>& batch() const { return batch_; }
+    void clear() { batch_.clear(); }
+
+    /// 以追加方式打开账簿文件 / Открытие файла книги на дозапись
+    bool open(const std::string& path);
+    bool recording() const { return file_ != nullptr; }
+
+    /// 把批次的前 count 笔记入账簿并清空批次 / Запись первых count проводок пакета в книгу и очистка пакета
+    void record(std::size_t count, unsigned long long day, unsigned long long hour, unsigned long long minute);
+
+    /// 把积累的记录写入文件 / Запись накопленных записей в файл
+    bool flush();
+
+    void close();
+
+private:
+    std::vector<Posting> batch_;
+    BinaryWriter records_;
+    std::FILE* file_{nullptr};
+};
+
+/// 读取整个账簿文件；不完整的尾部忽略 / Чтение файла книги; неполный хвост игнорируется
+bool readLedger(const std::string& path, std::vector<LedgerRecord>& records);
+
+}  // namespace bank
@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file NameIndex.hpp
+ * @brief 客户姓名索引：完美哈希 + 运行时溢出表 / Индекс имён клиентов: совершенный хеш + таблица переполнения
+ *
+ * 初始数据中的客户在加载后不再变化，因此为它们构造一次完美哈希（hash-and-displace）：
+ * 每个桶存一个种子，查找时两次哈希直达唯一候选槽，再比较一次字符串。
+ * 运行时新注册的客户放入按 string_view 异构查找的溢出哈希表。
+ * 查找只接受 string_view，不构造 std::string，因此不分配内存。
+ *
+ * Клиенты из начальных данных после загрузки не меняются, поэтому для них один раз
+ * строится совершенный хеш (hash-and-displace): у каждой корзины свой seed, поиск -
+ * два хеширования до единственной ячейки-кандидата и одно сравнение строк.
+ * Клиенты, зарегистрированные во время работы, попадают в таблицу переполнения с
+ * гетерогенным поиском по string_view. Поиск принимает только string_view и не создаёт
+ * std::string, поэтому не выделяет память.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bank {
+
+class NameIndex {
+public:
+    /**
+     * @brief 为固定的姓名集合构造完美哈希 / Построение совершенного хеша для фиксированного набора имён
+     *
+     * 重名时保留最后一个编号（与 map[name] = id 相同）；溢出表被清空。
+     * При повторе имени остаётся последний номер (как map[name] = id); переполнение очищается.
+     */
+    void build(const std::vector<std::pair<std::string_view, unsigned long long>>& entries) {
+        clear();
+        std::unordered_map<std::string_view, unsigned long long> unique;
+        unique.reserve(entries.size());
+        for (const auto& [name, id] : entries) unique[name] = id;
+        if (unique.empty()) return;
+
+        std::vector<std::pair<std::string_view, unsigned long long>> keys(unique.begin(), unique.end());
+        // 槽数略多于键数，种子搜索很快结束；失败时（极少）再放大
+        // Ячеек немного больше, чем ключей, поэтому поиск seed быстрый; при неудаче (редко) их больше
+        for (std::size_t slots = keys.size() + keys.size() / 4 + 1;; slots *= 2) {
+            if (place(keys, slots)) break;
+        }
+    }
+
+    /// 登记运行时新增的姓名 / Регистрация имени, добавленного во время работы
+    void insert(std::string_view name, unsigned long long id) {
+        if (auto* slot = findSlot(name)) {
+            slot->id = id;
+            return;
+        }
+        overflow_.insert_or_assign(std::pmr::string(name, &pool_), id);
+    }
+
+    /// 查找编号，不存在返回 nullptr / Поиск номера, nullptr если имени нет
+    const unsigned long long* find(std::string_view name) const {
+        if (const auto* slot = findSlot(name)) return &slot->id;
+        if (overflow_.empty()) return nullptr;
+        auto it = overflow_.find(name);
+        return it == overflow_.end() ? nullptr : &it->second;
+    }
+
+    std::size_t size() const { return placed_ + overflow_.size(); }
+
+    void clear() {
+        seeds_.clear();
+        slots_.clear();
+        arena_.clear();
+        placed_ = 0;
+        overflow_.clear();
+    }
+
+private:
+    struct Slot {
+        std::uint32_t offset{};         ///< 姓名在 arena_ 中的起点 / Начало имени в arena_
+        std::uint32_t length{};         ///< 姓名长度 / Длина имени
+        unsigned long long id{};        ///< 客户编号 / Номер клиента
+        bool used{false};
+    };
+
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    // FNV-1a + splitmix64 收尾；seed 改变初值 / FNV-1a с финализатором splitmix64; seed меняет начальное значение
+    static std::uint64_t hashName(std::string_view name, std::uint64_t seed) {
+        std::uint64_t h = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+        for (const char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ULL;
+        }
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    std::string_view slotName(const Slot& slot) const { return {arena_.data() + slot.offset, slot.length}; }
+
+    const Slot* findSlot(std::string_view name) const {
+        if (slots_.empty()) return nullptr;
+        const auto seed = seeds_[hashName(name, 0) % seeds_.size()];
+        const auto& slot = slots_[hashName(name, seed) % slots_.size()];
+        return slot.used && slotName(slot) == name ? &slot : nullptr;
+    }
+
+    Slot* findSlot(std::string_view name) {
+        return const_cast<Slot*>(static_cast<const NameIndex&>(*this).findSlot(name));
+    }
+
+    /**
+     * @brief 按桶从大到小为每个桶找到无冲突的种子 / Подбор seed без коллизий для корзин от больших к малым
+     *
+     * @return false 表示某个桶在尝试上限内找不到种子 / false - для какой-то корзины seed не найден
+     */
+    bool place(const std::vector<std::pair<std::string_view, unsigned long long>>& keys, std::size_t slotCount) {
+        constexpr std::uint32_t kMaxSeed = 1u << 16;
+        const std::size_t bucketCount = keys.size() / 4 + 1;
+        std::vector<std::vector<std::size_t>> buckets(bucketCount);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            buckets[hashName(keys[i].first, 0) % bucketCount].push_back(i);
+        }
+        std::vector<std::size_t> order(bucketCount);
+        for (std::size_t b = 0; b < bucketCount; ++b) order[b] = b;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        seeds_.assign(bucketCount, 0);
+        slots_.assign(slotCount, Slot{});
+        arena_.clear();
+        std::vector<std::size_t> taken;
+        for (const auto b : order) {
+            const auto& bucket = buckets[b];
+            if (bucket.empty()) break;
+            bool found = false;
+            for (std::uint32_t seed = 1; seed < kMaxSeed && !found; ++seed) {
+                taken.clear();
+                found = true;
+                for (const auto key : bucket) {
+                    const auto slot = hashName(keys[key].first, seed) % slotCount;
+                    if (slots_[slot].used || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                        found = false;
+                        break;
+                    }
+                    taken.push_back(slot);
+                }
+                if (!found) continue;
+                seeds_[b] = seed;
+                // 姓名连续存放，槽内只存偏移 / Имена хранятся подряд, в ячейке только смещение
+                for (std::size_t k = 0; k < bucket.size(); ++k) {
+                    const auto& [name, id] = keys[bucket[k]];
+                    auto& slot = slots_[taken[k]];
+                    slot.offset = static_cast<std::uint32_t>(arena_.size());
+                    slot.length = static_cast<std::uint32_t>(name.size());
+                    slot.id = id;
+                    slot.used = true;
+                    arena_.append(name);
+                }
+            }
+            if (!found) return false;
+        }
+        placed_ = keys.size();
+        return true;
+    }
+
+    std::vector<std::uint32_t> seeds_;          ///< 每个桶的种子 / Seed каждой корзины
+    std::vector<Slot> slots_;                   ///< 完美哈希槽 / Ячейки совершенного хеша
+    std::string arena_;                         ///< 全部姓名 / Все имена подряд
+    std::size_t placed_{0};                     ///< 完美哈希中的姓名数 / Число имён в совершенном хеше
+    std::pmr::unsynchronized_pool_resource pool_;  ///< 溢出表节点与姓名的池 / Пул узлов и имён таблицы переполнения
+    std::pmr::unordered_map<std::pmr::string, unsigned long long, NameHash, std::equal_to<>> overflow_{&pool_};
+};
+
+}  // namespace bank
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file Output.hpp
+ * @brief 带大缓冲的输出通道 / Канал вывода с большим буфером
+ *
+ * 业务响应（stdout）与交易日志（stderr）都先写入内存缓冲，仅在缓冲满、
+ * 银行营业日结束或程序退出时才真正调用 write。stderr 本身无缓冲，
+ * 原先每条转账日志都是一次系统调用。
+ *
+ * Ответы (stdout) и журнал транзакций (stderr) сначала пишутся в буфер в памяти
+ * и реально выводятся только при заполнении буфера, в конце банковского дня или
+ * при завершении программы. stderr не буферизуется, поэтому раньше каждая строка
+ * журнала переводов была отдельным системным вызовом.
+ */
+
+#include "Domain.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace io {
+
+/**
+ * @brief 缓冲输出通道 / Буферизованный канал вывода
+ *
+ * file 为 nullptr 时只在内存中累积，可通过 view() 取出（用于捕获输出）。
+ * Если file == nullptr, данные только накапливаются в памяти и доступны через view()
+ * (для перехвата вывода).
+ */
+class OutputSink {
+public:
+    static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 20;
+
+    explicit OutputSink(std::FILE* file, std::size_t capacity = kDefaultCapacity);
+    ~OutputSink();
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    /// 写入原始文本 / Запись текста
+    OutputSink& text(std::string_view value) {
+        if (capacity_ - size_ < value.size()) {
+            if (!grow(value.size())) return writeThrough(value);
+        }
+        for (char c : value) data_[size_++] = c;
+        return *this;
+    }
+
+    /// 写入单个字符 / Запись одного символа
+    OutputSink& put(char c) {
+        if (size_ == capacity_) grow(1);
+        data_[size_++] = c;
+        return *this;
+    }
+
+    /// 写入无符号整数（不经 printf）/ Запись беззнакового целого (без printf)
+    OutputSink& number(unsigned long long value) {
+        ensure(20);
+        char digits[20];
+        std::size_t n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (n > 0) data_[size_++] = digits[--n];
+        return *this;
+    }
+
+    /// 写入金额 "[-]major.mmm" / Запись суммы "[-]major.mmm"
+    OutputSink& money(domain::Money amount) {
+        ensure(domain::kMaxMoneyText);
+        size_ = static_cast<std::size_t>(domain::writeMoney(data_ + size_, amount) - data_);
+        return *this;
+    }
+
+    /**
+     * @brief 把缓冲写入文件 / Сброс буфера в файл
+     *
+     * 对内存通道无效果。/ Для канала в памяти ничего не делает.
+     */
+    void flush();
+
+    /// 已缓冲内容 / Накопленное содержимое
+    std::string_view view() const { return {data_, size_}; }
+
+    /// 清空内存内容（不写出）/ Очистка содержимого без вывода
+    void clear() { size_ = 0; }
+
+    std::FILE* file() const { return file_; }
+
+private:
+    void ensure(std::size_t n) {
+        if (capacity_ - size_ < n) grow(n);
+    }
+    bool grow(std::size_t n);
+    OutputSink& writeThrough(std::string_view value);
+
+    std::FILE* file_;
+    std::vector<char> storage_;
+    char* data_;
+    std::size_t size_{0};
+    std::size_t capacity_;
+};
+
+}  // namespace io
@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file Profiler.hpp
+ * @brief 按操作类型的延迟直方图 / Гистограммы задержек по типам операций
+ *
+ * 用 -DBANK_PROFILE=ON 构建时，每个客户操作（执行 + 提交）的耗时按操作类型
+ * 记入 HDR 风格的对数-线性直方图，营业日结束时把次数与 p50/p99/p999 写入单独的统计通道
+ * （耗时每次运行都不同，不能混入格式固定的交易日志）。
+ * 关闭时 BANK_PROFILE_SCOPE 展开为空，BankSystem 中也没有任何计时代码或数据。
+ *
+ * При сборке с -DBANK_PROFILE=ON время каждой клиентской операции (выполнение +
+ * фиксация) записывается по типу операции в лог-линейную гистограмму в стиле HDR;
+ * в конце банковского дня число операций и p50/p99/p999 выводятся в отдельный канал
+ * статистики (время меняется от запуска к запуску и не должно попадать в журнал
+ * транзакций с фиксированным форматом).
+ * При отключении BANK_PROFILE_SCOPE раскрывается в пустоту, и в BankSystem нет ни
+ * кода замеров, ни данных.
+ */
+
+#include "Domain.hpp"
+#include "Output.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace bank {
+
+/**
+ * @brief 对数-线性直方图 / Лог-линейная гистограмма
+ *
+ * 每个 2 的幂区间再分 16 个子桶，任意值的相对误差不超过 1/16；
+ * 记录与查询都不分配内存。
+ * Каждый интервал между степенями двойки делится на 16 подкорзин, относительная
+ * погрешность не больше 1/16; запись и запрос без выделения памяти.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBits = 4;
+    static constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    void record(std::uint64_t value) {
+        ++counts_[bucketOf(value)];
+        ++total_;
+        if (value > max_) max_ = value;
+    }
+
+    std::uint64_t count() const { return total_; }
+    std::uint64_t max() const { return max_; }
+
+    /**
+     * @brief 分位数（所在桶的上界，不超过最大值）/ Квантиль (верхняя граница корзины, не больше максимума)
+     *
+     * @param q 0..1
+     */
+    std::uint64_t percentile(double q) const {
+        if (total_ == 0) return 0;
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total_) + 0.5);
+        if (rank == 0) rank = 1;
+        if (rank > total_) rank = total_;
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) return std::min(upperBound(bucket), max_);
+        }
+        return max_;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) counts_[bucket] += other.counts_[bucket];
+        total_ += other.total_;
+        if (other.max_ > max_) max_ = other.max_;
+    }
+
+    void clear() { *this = LatencyHistogram{}; }
+
+    /// 值所在的桶 / Корзина значения
+    static std::size_t bucketOf(std::uint64_t value) {
+        if (value < kSubBuckets) return static_cast<std::size_t>(value);
+        const unsigned exponent = static_cast<unsigned>(std::bit_width(value)) - 1;   // >= kSubBits
+        const auto mantissa = (value >> (exponent - kSubBits)) & (kSubBuckets - 1);
+        return static_cast<std::size_t>((exponent - kSubBits + 1) * kSubBuckets + mantissa);
+    }
+
+    /// 桶内最大的值 / Наибольшее значение корзины
+    static std::uint64_t upperBound(std::size_t bucket) {
+        if (bucket < kSubBuckets) return bucket;
+        const unsigned exponent = static_cast<unsigned>(bucket / kSubBuckets) + kSubBits - 1;
+        const auto mantissa = static_cast<std::uint64_t>(bucket % kSubBuckets);
+        const auto lower = (kSubBuckets + mantissa) << (exponent - kSubBits);
+        return lower + (std::uint64_t{1} << (exponent - kSubBits)) - 1;
+    }
+
+private:
+    std::array<std::uint64_t, kBuckets> counts_{};
+    std::uint64_t total_{0};
+    std::uint64_t max_{0};
+};
+
+/// 各操作类型的直方图；未知操作单独一行 / Гистограммы по типам операций; неизвестные операции - отдельной строкой
+class OperationProfiler {
+public:
+    void record(domain::Operation op, std::uint64_t nanos) {
+        histograms_[static_cast<std::size_t>(op)].record(nanos);
+    }
+
+    const LatencyHistogram& histogram(domain::Operation op) const { return histograms_[static_cast<std::size_t>(op)]; }
+
+    /**
+     * @brief 输出当天的统计并清零 / Вывод статистики за день и обнуление
+     *
+     * 每种出现过的操作一行："%llu # profile # <操作> # 次数 # p50 # p99 # p999 # max"，单位纳秒。
+     * По строке на каждую встречавшуюся операцию: "%llu # profile # <операция> # число # p50 # p99 # p999 # max", в наносекундах.
+     */
+    void report(unsigned long long day, io::OutputSink& sink) {
+        for (std::size_t index = 0; index < histograms_.size(); ++index) {
+            auto& histogram = histograms_[index];
+            if (histogram.count() == 0) continue;
+            sink.number(day).text(" # profile # ").text(domain::toString(static_cast<domain::Operation>(index)))
+                .text(" # ").number(histogram.count());
+            for (const double q : {0.5, 0.99, 0.999}) sink.text(" # ").number(histogram.percentile(q));
+            sink.text(" # ").number(histogram.max()).put('\n');
+            histogram.clear();
+        }
+    }
+
+    /// 清零而不输出 / Обнуление без вывода
+    void clear() {
+        for (auto& histogram : histograms_) histogram.clear();
+    }
+
+private:
+    std::array<LatencyHistogram, domain::kOperationCount + 1> histograms_{};
+};
+
+/**
+ * @brief 作用域计时 / Замер области
+ *
+ * 析构时把耗时加到 nanos，或者连同此前累计的 carried 一起记入 profiler。
+ * При разрушении время прибавляется к nanos или вместе с накопленным carried записывается в profiler.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(std::uint64_t& nanos) : nanos_(&nanos), start_(std::chrono::steady_clock::now()) {}
+    ProfileScope(OperationProfiler& profiler, domain::Operation op, std::uint64_t carried = 0)
+        : profiler_(&profiler), op_(op), carried_(carried), start_(std::chrono::steady_clock::now()) {}
+    ~ProfileScope() {
+        const auto elapsed = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        if (nanos_) {
+            *nanos_ += elapsed;
+        } else {
+            profiler_->record(op_, carried_ + elapsed);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    std::uint64_t* nanos_{nullptr};
+    OperationProfiler* profiler_{nullptr};
+    domain::Operation op_{domain::Operation::Unknown};
+    std::uint64_t carried_{0};
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace bank
+
+#if BANK_PROFILE
+#define BANK_PROFILE_CONCAT_(a, b) a##b
+#define BANK_PROFILE_CONCAT(a, b) BANK_PROFILE_CONCAT_(a, b)
+/// 计时到当前作用域结束，参数同 ProfileScope / Замер до конца текущей области, аргументы как у ProfileScope
+#define BANK_PROFILE_SCOPE(...) ::bank::ProfileScope BANK_PROFILE_CONCAT(bankProfileScope_, __LINE__)(__VA_ARGS__)
+#else
+#define BANK_PROFILE_SCOPE(...) ((void)0)
+#endif
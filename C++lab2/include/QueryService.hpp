@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file QueryService.hpp
+ * @brief 只读查询服务：在重放事件的同时按快照回答余额查询 / Сервис запросов: ответы на запросы баланса по снимку во время воспроизведения
+ *
+ * 唯一的写线程（运行 BankSystem::run 的线程）按固定间隔以及每个营业日结束时
+ * 把账户表复制成不可变的 BankSnapshot 并原子地发布（RCU：读者持有旧快照的引用，
+ * 最后一个读者释放时旧快照才被回收）。读线程只读取已发布的快照，从不接触
+ * BankSystem 的内部数据，因此重放无需停顿，读者也看不到半个事件的状态。
+ *
+ * 请求与应答都是一行文本，格式沿用输入文件的 " # " 分隔：
+ *   Balance Inquiry # <账号>   -> "日 # 时:分 # Balance of <账号> # <余额> # <币种>"
+ *   Client Accounts # <客户ID> -> "日 # 时:分 # Accounts of <客户ID> # <账号> # <余额> # <币种> ..."
+ *   Day Stats                  -> "日 # 时:分 # Day Stats # 来访 # 操作 # 转账 # <各币种手续费>"
+ *   Balance As Of # <账号> # <日> # <时>:<分>
+ *                              -> "日 # 时:分 # Balance of <账号> as of <日> # <时>:<分> # <余额> # <币种>"
+ *                                 （需开启余额历史，重放结束后可用 / нужна история остатков, доступно после воспроизведения）
+ *
+ * Единственный поток записи (тот, что выполняет BankSystem::run) с заданным интервалом
+ * и в конце каждого банковского дня копирует таблицу счетов в неизменяемый BankSnapshot
+ * и атомарно его публикует (RCU: читатели держат ссылку на старый снимок, он освобождается
+ * последним читателем). Потоки чтения видят только опубликованные снимки и не касаются
+ * внутренних данных BankSystem, поэтому воспроизведение не останавливается, а читатели
+ * не видят состояния посреди события.
+ *
+ * Запрос и ответ - одна строка текста с разделителем " # ", как во входном файле
+ * (форматы см. выше).
+ */
+
+#include "BalanceHistory.hpp"
+#include "Domain.hpp"
+#include "Output.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bank {
+
+/// 快照中的一个账户 / Счёт в снимке
+struct AccountView {
+    unsigned long long id{};                            ///< 账号 / Номер счёта
+    unsigned long long owner{};                         ///< 所有者客户ID / ID владельца
+    domain::Money balance{};                            ///< 余额 / Остаток
+    domain::Currency currency{domain::Currency::Unknown};
+    domain::AccountKind type{domain::AccountKind::Unknown};
+    bool hasOwner{false};
+    bool active{true};
+};
+
+/**
+ * @brief 不可变的银行状态快照 / Неизменяемый снимок состояния банка
+ */
+struct BankSnapshot {
+    domain::DateTime time{};                            ///< 快照时的模拟时间 / Время симуляции в момент снимка
+    unsigned long long appeals{};                       ///< 当天来访数 / Обращений за день
+    unsigned long long operations{};                    ///< 当天操作数 / Операций за день
+    unsigned long long transfers{};                     ///< 当天转账日志条数 / Записей журнала переводов за день
+    std::array<domain::Money, domain::kCurrencyCount> fees{};   ///< 当天各币种手续费 / Комиссии за день по валютам
+    std::vector<AccountView> accounts;                  ///< 按账号排序 / Отсортированы по номеру
+    std::vector<std::uint32_t> byOwner;                 ///< 有主账户的下标，按 (所有者, 账号) 排序 / Индексы счетов с владельцем по (владелец, номер)
+    std::shared_ptr<const BalanceHistory> history;      ///< 余额历史，只在重放结束后发布 / История остатков, публикуется только после воспроизведения
+
+    /// 建立 byOwner 索引；accounts 须已按账号排序 / Построение byOwner; accounts уже отсортированы по номеру
+    void index();
+
+    const AccountView* find(unsigned long long id) const;
+};
+
+/**
+ * @brief Unix 域套接字上的只读查询服务 / Сервис запросов только для чтения на Unix-сокете
+ *
+ * 多个读线程共用一个非阻塞的监听套接字，每个线程用 poll 服务自己接受的连接。
+ * Несколько потоков чтения делят неблокирующий слушающий сокет, каждый через poll
+ * обслуживает принятые им соединения.
+ */
+class QueryService {
+public:
+    /// @param threads 读线程数，0 表示硬件并发数 / Число потоков чтения, 0 - аппаратный параллелизм
+    explicit QueryService(std::size_t threads = 0);
+    ~QueryService();
+
+    QueryService(const QueryService&) = delete;
+    QueryService& operator=(const QueryService&) = delete;
+
+    /**
+     * @brief 在 socketPath 上开始监听 / Начало прослушивания socketPath
+     *
+     * 已存在的同名套接字文件会被替换。
+     * Существующий файл сокета с тем же именем заменяется.
+     *
+     * @return 是否成功；失败原因已写入 stderr / Успешно ли; причина ошибки уже в stderr
+     */
+    bool start(const std::string& socketPath);
+
+    /// 停止读线程并删除套接字文件 / Остановка потоков чтения и удаление файла сокета
+    void stop();
+
+    /// 两次发布之间的最短间隔（写线程调用）/ Минимальный интервал между публикациями (вызывает поток записи)
+    void setPublishInterval(std::chrono::milliseconds interval) { interval_ = interval; }
+
+    /// 距上次发布是否已超过间隔（写线程调用）/ Прошёл ли интервал после последней публикации (поток записи)
+    bool due() const { return std::chrono::steady_clock::now() - lastPublish_ >= interval_; }
+
+    /// 发布新快照（写线程调用）/ Публикация нового снимка (вызывает поток записи)
+    void publish(std::shared_ptr<const BankSnapshot> snapshot);
+
+    /// 当前快照，未发布时为空 / Текущий снимок, пусто до первой публикации
+    std::shared_ptr<const BankSnapshot> snapshot() const { return current_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 按当前快照回答一行请求（不含换行）/ Ответ на строку запроса (без перевода строки) по текущему снимку
+     *
+     * 应答以换行结尾追加到 reply。
+     * Ответ с переводом строки дописывается в reply.
+     */
+    void answer(std::string_view request, io::OutputSink& reply) const;
+
+private:
+    void serve();
+
+    std::size_t threads_;
+    std::atomic<std::shared_ptr<const BankSnapshot>> current_;
+    std::chrono::milliseconds interval_{10};
+    std::chrono::steady_clock::time_point lastPublish_{};
+    std::string path_;
+    int listenFd_{-1};
+    int wakeFds_[2]{-1, -1};                ///< 停止时写入，唤醒所有 poll / Запись при остановке будит все poll
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace bank
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file RuleEngine.hpp
+ * @brief 过账流上的风控规则 / Правила контроля мошенничества на потоке проводок
+ *
+ * 规则文件每行一条（空行忽略）：
+ *   Velocity # <次数> # <分钟>         客户在任意 <分钟> 内发起的过账超过 <次数>
+ *   Large Transfer # <金额> # <币种>    单笔过账不少于 <金额>（按账户币种）
+ *   Accounts Opened # <次数> # <分钟>  客户在任意 <分钟> 内开户超过 <次数>（1440 - 一天）
+ * 载入时编译成两份扁平计划（过账、开户），每步是一条定长记录，求值就是顺序走一遍计划。
+ * 计数规则的滑动窗口是每个客户一个 <次数> 个时间戳的环形缓冲：新事件与即将被覆盖的
+ * 最旧时间戳相差不到 <分钟> 即超限。所有客户的缓冲在一个连续数组里，只在客户第一次
+ * 出现时扩展，求值本身不分配内存。
+ *
+ * Файл правил - по одному правилу в строке (пустые строки пропускаются):
+ *   Velocity # <число> # <минуты>         клиент инициировал больше <число> проводок за любые <минуты>
+ *   Large Transfer # <сумма> # <валюта>   одна проводка не меньше <сумма> (в валюте счёта)
+ *   Accounts Opened # <число> # <минуты>  клиент открыл больше <число> счетов за любые <минуты> (1440 - сутки)
+ * При загрузке правила компилируются в два плоских плана (проводки, открытия счетов) из
+ * записей фиксированного размера; вычисление - один проход по плану. Скользящее окно
+ * счётного правила - кольцевой буфер из <число> меток времени на клиента: если новое
+ * событие отстоит от самой старой (перезаписываемой) метки меньше чем на <минуты>, предел
+ * превышен. Буферы всех клиентов лежат в одном непрерывном массиве, который растёт только
+ * при первом появлении клиента; само вычисление памяти не выделяет.
+ */
+
+#include "DenseTable.hpp"
+#include "Domain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bank {
+
+/// 规则类型 / Тип правила
+enum class RuleKind : std::uint8_t {
+    Velocity,           ///< 过账频率 / Частота проводок
+    LargeTransfer,      ///< 大额过账 / Крупная проводка
+    AccountsOpened,     ///< 开户频率 / Частота открытия счетов
+};
+
+/// 规则名（与规则文件一致）/ Имя правила (как в файле правил)
+const char* toString(RuleKind kind);
+
+/// 一次触发 / Одно срабатывание
+struct RuleAlert {
+    std::uint32_t rule{};               ///< 规则在文件中的序号（从 1 起）/ Номер правила в файле (с 1)
+    RuleKind kind{RuleKind::Velocity};
+    unsigned long long clientId{};
+    unsigned long long accountId{};
+    domain::Money amount{};             ///< 过账金额（开户为 0）/ Сумма проводки (0 при открытии счёта)
+};
+
+class RuleEngine {
+public:
+    static constexpr std::uint32_t kMaxLimit = 1024;    ///< 计数规则的次数上限 / Предел числа в счётных правилах
+
+    /// 读取并编译规则文件；错误写入 stderr / Чтение и компиляция файла правил; ошибки в stderr
+    bool load(const std::string& path);
+
+    /// 解析并编译规则文本，替换已有规则 / Разбор и компиляция текста правил вместо прежних
+    bool parse(std::string_view text);
+
+    std::size_t rules() const { return postingPlan_.size() + openingPlan_.size(); }
+
+    /**
+     * @brief 客户发起的一笔过账 / Проводка, инициированная клиентом
+     *
+     * @return 本次触发的规则，下一次调用前有效 / Сработавшие правила; действительны до следующего вызова
+     */
+    std::span<const RuleAlert> onPosting(const domain::DateTime& time,
+                                         unsigned long long clientId,
+                                         unsigned long long accountId,
+                                         domain::Currency currency,
+                                         domain::Money amount);
+
+    /// 客户开了一个账户 / Клиент открыл счёт
+    std::span<const RuleAlert> onAccountOpened(const domain::DateTime& time,
+                                               unsigned long long clientId,
+                                               unsigned long long accountId);
+
+private:
+    /// 计划中的一步 / Шаг плана
+    struct Step {
+        RuleKind kind{RuleKind::Velocity};
+        std::int8_t currency{-1};       ///< 大额规则的币种下标 / Индекс валюты крупной проводки
+        std::uint32_t rule{};
+        std::uint32_t limit{};          ///< 计数规则：环形缓冲长度 / Счётное правило: длина кольца
+        std::uint32_t window{};         ///< 计数规则：窗口（分钟）/ Счётное правило: окно (минуты)
+        std::uint32_t offset{};         ///< 计数规则：在客户状态中的起点 / Счётное правило: начало в состоянии клиента
+        std::int64_t threshold{};       ///< 大额规则：金额（千分位）/ Крупная проводка: сумма (в тысячных)
+    };
+
+    static constexpr std::uint32_t kEmpty = ~std::uint32_t{0};
+
+    /// 自第 0 天起的分钟数 / Минуты от дня 0
+    static std::uint32_t toMinute(const domain::DateTime& time) {
+        return static_cast<std::uint32_t>((time.day * 24 + time.hour) * 60 + time.minute);
+    }
+
+    std::uint32_t clientState(unsigned long long clientId);
+    bool exceeds(const Step& step, std::uint32_t base, std::uint32_t minute);
+    void run(const std::vector<Step>& plan, std::uint32_t minute, unsigned long long clientId,
+             unsigned long long accountId, std::int8_t currency, domain::Money amount);
+
+    std::vector<Step> postingPlan_;
+    std::vector<Step> openingPlan_;
+    std::uint32_t stride_{0};                   ///< 每个客户的计数槽数 / Счётных ячеек на клиента
+    DenseTable<std::uint32_t> clientBase_;      ///< 客户状态在 slots_ 中的起点 / Начало состояния клиента в slots_
+    std::vector<std::uint32_t> slots_;          ///< 各客户的 [头, 时间戳...] / [голова, метки...] клиентов
+    std::vector<RuleAlert> alerts_;             ///< 按计划长度预留 / Резерв по длине плана
+};
+
+}  // namespace bank
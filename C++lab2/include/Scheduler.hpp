@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file Scheduler.hpp
+ * @brief 工作岗位排队的离散事件模拟 / Дискретно-событийная модель очередей к рабочим местам
+ *
+ * 客户到达后按所需岗位领取号码排队；VIP 客户在同类岗位前优先；
+ * 需要多个岗位时，在一个岗位办完后重新取号。时间线是按时间排序的事件堆，
+ * 每个营业日结束时一次性推进，统计各岗位服务人数与等待时间分布。
+ *
+ * Клиент по прибытии берёт номер в очередь к нужному рабочему месту; VIP-клиенты
+ * обслуживаются вне очереди у мест того же типа; если нужно несколько мест, после
+ * одного клиент берёт новый номер. Временная шкала - куча событий по времени,
+ * прогоняется целиком в конце банковского дня и даёт число обслуженных по местам
+ * и распределение времени ожидания.
+ */
+
+#include "Domain.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace bank {
+
+/**
+ * @brief 一个营业日的排队结果 / Итоги очередей за банковский день
+ */
+struct QueueReport {
+    /// [岗位类型][岗位序号] -> 服务人次 / [тип места][номер места] -> обслужено
+    std::array<std::vector<unsigned long long>, domain::kWorkplaceKindCount> served{};
+    unsigned long long customers{};     ///< 到达的客户 / Пришедших клиентов
+    unsigned long long turnedAway{};    ///< 营业结束时未办完的客户 / Не обслуженных до закрытия
+    /// 每位客户累计等待分钟数的直方图 / Гистограмма суммарного ожидания клиента в минутах
+    std::vector<unsigned long long> waitHistogram;
+};
+
+/**
+ * @brief 由等待直方图求分位数 / Квантиль по гистограмме ожидания
+ *
+ * @param q 分位（0..1）/ Уровень квантиля (0..1)
+ * @return 等待分钟数 / Ожидание в минутах
+ */
+unsigned long long waitPercentile(const std::vector<unsigned long long>& histogram, double q);
+
+/**
+ * @brief 工作岗位调度器 / Планировщик рабочих мест
+ */
+class WorkplaceScheduler {
+public:
+    static constexpr std::uint32_t kOpenMinute = 8 * 60;     ///< 8:00
+    static constexpr std::uint32_t kCloseMinute = 19 * 60;   ///< 19:00
+
+    /// 设置各类岗位数量 / Количество мест каждого типа
+    void configure(const std::vector<domain::WorkplaceDefinition>& workplaces);
+
+    /// 开始新的营业日，清空到达记录 / Начало нового дня, очистка прибытий
+    void startDay();
+
+    /**
+     * @brief 登记一位客户 / Регистрация клиента
+     *
+     * @param arrivalMinute 到达时刻（自 0:00 起的分钟）/ Время прибытия (минуты от 0:00)
+     * @param vip 是否优先 / VIP ли клиент
+     */
+    void addCustomer(std::uint32_t arrivalMinute, bool vip);
+
+    /// 为最近登记的客户追加一项服务 / Добавление услуги последнему клиенту
+    void addService(domain::WorkplaceKind kind, std::uint32_t minutes);
+
+    /// 推进整个营业日并返回结果 / Прогон всего дня и итоги
+    QueueReport finishDay();
+
+private:
+    // 同一岗位上连续的服务合并为一次取号 / Услуги подряд у одного места - один номер
+    struct Stage {
+        domain::WorkplaceKind kind;
+        std::uint32_t minutes;
+    };
+
+    struct Customer {
+        std::uint32_t arrival;
+        std::uint32_t firstStage;
+        std::uint32_t stageCount;
+        std::uint32_t waited;       ///< 累计等待 / Суммарное ожидание
+        std::uint32_t enqueuedAt;   ///< 当前号码的取号时刻 / Время получения текущего номера
+        std::uint32_t nextStage;    ///< 下一个要办的阶段 / Следующий этап
+        bool vip;
+    };
+
+    enum class EventType : std::uint8_t { Completion, Arrival };
+
+    struct Event {
+        std::uint32_t time;
+        EventType type;             ///< 同一时刻先释放岗位再取号 / В один момент сначала освобождение места
+        std::uint32_t seq;          ///< 同时事件按发生顺序 / Одновременные события по порядку
+        std::uint32_t customer;
+        std::uint32_t instance;     ///< Completion：岗位序号 / Completion: номер места
+        domain::WorkplaceKind kind; ///< Completion：岗位类型 / Completion: тип места
+    };
+
+    struct EventLater {
+        bool operator()(const Event& a, const Event& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            if (a.type != b.type) return a.type > b.type;
+            return a.seq > b.seq;
+        }
+    };
+
+    // 一类岗位的两条队列与空闲岗位 / Две очереди и свободные места одного типа
+    struct Line {
+        std::vector<std::uint32_t> vip;
+        std::vector<std::uint32_t> regular;
+        std::size_t vipHead{0};
+        std::size_t regularHead{0};
+        std::vector<std::uint32_t> freeInstances;   ///< 最小堆 / Мин-куча
+    };
+
+    domain::WorkplaceKind resolve(domain::WorkplaceKind kind) const;
+    void push(Event event);
+    void arrive(std::uint32_t now, std::uint32_t customer);
+    void dispatch(std::uint32_t now, domain::WorkplaceKind kind);
+
+    std::array<std::uint32_t, domain::kWorkplaceKindCount> counts_{};
+    std::vector<Customer> customers_;
+    std::vector<Stage> stages_;
+    std::vector<Event> timeline_;
+    std::uint32_t seq_{0};
+    std::array<Line, domain::kWorkplaceKindCount> lines_{};
+    QueueReport report_{};
+};
+
+}  // namespace bank
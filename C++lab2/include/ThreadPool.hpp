@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file ThreadPool.hpp
+ * @brief 工作窃取线程池 / Пул потоков с перехватом задач
+ *
+ * 每个工作线程有自己的双端队列：自己从尾部取任务（后进先出，缓存友好），
+ * 空闲时从其他线程队列的头部窃取。各分行任务耗时差异很大，
+ * 窃取可以避免个别长任务拖住整批。
+ *
+ * У каждого рабочего потока своя двусторонняя очередь: свои задачи берутся
+ * с хвоста (LIFO, дружелюбно к кешу), а простаивающий поток забирает задачи
+ * с головы чужих очередей. Длительность задач по отделениям сильно различается,
+ * и перехват не даёт отдельной долгой задаче задержать весь пакет.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bank {
+
+/**
+ * @brief 工作窃取线程池 / Пул потоков с перехватом задач
+ *
+ * 任务内部再次 submit 的子任务进入当前线程自己的队列。
+ * Подзадачи, отправленные изнутри задачи, попадают в очередь текущего потока.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /// @param threads 线程数，0 表示硬件并发数 / Число потоков, 0 - аппаратный параллелизм
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /// 等待全部任务完成后停止线程 / Ожидает завершения всех задач и останавливает потоки
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// 提交任务 / Отправка задачи
+    void submit(Task task);
+
+    /// 阻塞直到所有已提交任务（含子任务）完成 / Блокировка до завершения всех задач (включая подзадачи)
+    void wait();
+
+    std::size_t size() const { return workers_.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(std::size_t self);
+    bool tryTake(std::size_t self, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> nextQueue_{0};     ///< 外部提交的轮转位置 / Позиция round-robin для внешних задач
+
+    std::mutex stateMutex_;
+    std::condition_variable wake_;              ///< 有新任务或停止 / Новая задача или остановка
+    std::condition_variable idle_;              ///< 全部完成 / Всё выполнено
+    std::size_t queued_{0};                     ///< 在队列中的任务数 / Задач в очередях
+    std::size_t pending_{0};                    ///< 未完成的任务数 / Незавершённых задач
+    bool stopping_{false};
+};
+
+}  // namespace bank
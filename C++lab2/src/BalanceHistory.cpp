@@ -0,0 +1,107 @@
+#include "BalanceHistory.hpp"
+
+#include <algorithm>
+
+namespace bank {
+
+namespace {
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t getVarint(const std::uint8_t*& cursor) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        const auto byte = *cursor++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+}
+
+// zigzag：小的负数也编码成短的无符号数 / zigzag: малые отрицательные числа кодируются короткими беззнаковыми
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+}  // namespace
+
+void BalanceHistory::putDelta(std::vector<std::uint8_t>& out, std::uint32_t minutes, std::int64_t balance) {
+    putVarint(out, minutes);
+    putVarint(out, zigzag(balance));
+}
+
+void BalanceHistory::record(unsigned long long accountId, const domain::DateTime& time, domain::Money balance) {
+    auto& history = *accounts_.emplace(accountId, AccountHistory{}).first;
+    const auto value = balance.thousandths;
+    auto minute = toMinute(time);
+    if (history.count > 0) {
+        minute = std::max(minute, history.lastMinute);
+        if (value == history.lastBalance) return;
+        if (minute == history.lastMinute) {
+            // 同一分钟：改写最后一个版本 / Та же минута: перезапись последней версии
+            if ((history.count - 1) % kBlock == 0) {
+                history.checkpoints.back().balance = value;
+            } else {
+                history.deltas.resize(history.lastOffset);
+                putDelta(history.deltas, history.lastMinute - history.prevMinute, value - history.prevBalance);
+            }
+            history.lastBalance = value;
+            return;
+        }
+    }
+    if (history.count % kBlock == 0) {
+        history.checkpoints.push_back({minute, static_cast<std::uint32_t>(history.deltas.size()), value});
+    } else {
+        history.lastOffset = static_cast<std::uint32_t>(history.deltas.size());
+        putDelta(history.deltas, minute - history.lastMinute, value - history.lastBalance);
+    }
+    history.prevMinute = history.lastMinute;
+    history.prevBalance = history.lastBalance;
+    history.lastMinute = minute;
+    history.lastBalance = value;
+    ++history.count;
+    ++versions_;
+}
+
+std::optional<domain::Money> BalanceHistory::asOf(unsigned long long accountId, const domain::DateTime& time) const {
+    const auto* history = accounts_.find(accountId);
+    if (!history || history->checkpoints.empty()) return std::nullopt;
+    const auto minute = toMinute(time);
+    const auto& checkpoints = history->checkpoints;
+    auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), minute,
+                               [](std::uint32_t key, const Checkpoint& checkpoint) { return key < checkpoint.minute; });
+    if (it == checkpoints.begin()) return std::nullopt;
+    --it;
+
+    // 块内顺序解码到第一个晚于 time 的版本为止 / Декодирование блока до первой версии позже time
+    std::uint64_t current = it->minute;
+    auto balance = it->balance;
+    const auto* cursor = history->deltas.data() + it->offset;
+    const auto* end = std::next(it) == checkpoints.end() ? history->deltas.data() + history->deltas.size()
+                                                         : history->deltas.data() + std::next(it)->offset;
+    while (cursor != end) {
+        const auto next = current + getVarint(cursor);
+        const auto delta = unzigzag(getVarint(cursor));
+        if (next > minute) break;
+        current = next;
+        balance += delta;
+    }
+    return domain::Money::fromThousandths(balance);
+}
+
+std::size_t BalanceHistory::bytes() const {
+    std::size_t total = 0;
+    accounts_.forEach([&total](unsigned long long, const AccountHistory& history) {
+        total += sizeof(AccountHistory) + history.checkpoints.size() * sizeof(Checkpoint) + history.deltas.size();
+    });
+    return total;
+}
+
+}  // namespace bank
@@ -1,83 +1,106 @@
 #include "Bank.hpp"
 
+#include "QueryService.hpp"
+#include "ThreadPool.hpp"
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <charconv>
 #include <csignal>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <string_view>
 
 namespace {
 constexpr std::size_t kLineBuffer = 512;
-int kindIndex(domain::CustomerKind kind) {
-    switch (kind) {
-        case domain::CustomerKind::Individual: return 0;
-        case domain::CustomerKind::VipIndividual: return 1;
-        case domain::CustomerKind::Legal: return 2;
-        case domain::CustomerKind::VipLegal: return 3;
-        default: return -1;
-    }
+
+// 未提供的服务：不占用岗位时间 / Услуга не предоставляется: время места не занимает
+constexpr const char* kServiceNotAvailable = "Service not available";
+
+// 客户类型对应的权限位 / Бит права для типа клиента
+constexpr std::uint8_t permitBit(domain::CustomerKind kind) {
+    return static_cast<std::uint8_t>(1u << domain::customerIndex(kind));
 }
 
+constexpr std::uint8_t kAllClients = permitBit(domain::CustomerKind::Individual) |
+                                     permitBit(domain::CustomerKind::VipIndividual) |
+                                     permitBit(domain::CustomerKind::Legal) |
+                                     permitBit(domain::CustomerKind::VipLegal);
+
+// 操作权限表：每个操作一个位掩码，位对应客户类型（Individual, VipIndividual, Legal, VipLegal）
+// Таблица прав операций: по маске на операцию, биты - типы клиентов
+constexpr std::array<std::uint8_t, domain::kOperationCount + 1> kOperationPermissions = {
+    kAllClients,                                                            // Balance Inquiry
+    kAllClients,                                                            // Create Account
+    kAllClients,                                                            // Close Account
+    kAllClients,                                                            // Withdraw Funds
+    kAllClients,                                                            // Top-up Founds
+    kAllClients & ~permitBit(domain::CustomerKind::Legal),                  // Currency Exchange：Legal Entity 不能办理货币兑换
+    0,                                                                      // Request Debit Card：尚未开放 / пока не обслуживается
+    0,                                                                      // Unknown
+};
+
 // 策略模式：根据客户类型返回不同的客户对象 / Стратегия: в зависимости от типа клиента возвращает соответствующий объект
-bool isOperationAllowed(domain::CustomerKind kind, std::string_view operation) {
-    // 操作权限表：每行对应一种操作，列对应客户类型（Individual, VipIndividual, Legal, VipLegal）
-    // Таблица прав операций: каждая строка - операция, столбцы - типы клиентов
-    static const std::unordered_map<std::string_view, std::array<bool, 4>> table = {
-        {"Balance Inquiry", {true, true, true, true}},
-        {"Create Account", {true, true, true, true}},
-        {"Close Account", {true, true, true, true}},
-        {"Withdraw Funds", {true, true, true, true}},
-        {"Top-up Founds", {true, true, true, true}},
-        {"Currency Exchange", {true, true, false, true}},  // Legal Entity 不能办理货币兑换
-    };
-    const auto idx = kindIndex(kind);
-    if (idx < 0) return false;
-    auto it = table.find(operation);
-    if (it == table.end()) return false;
-    return it->second[idx];
+// NotClient 对应第 4 位，任何掩码中都不置位，因此无需分支。
+// NotClient соответствует биту 4, который не установлен ни в одной маске, поэтому ветвления не нужны.
+constexpr bool isOperationAllowed(domain::CustomerKind kind, domain::Operation operation) {
+    return (kOperationPermissions[static_cast<std::size_t>(operation)] >> static_cast<unsigned>(kind)) & 1u;
 }
+static_assert(!isOperationAllowed(domain::CustomerKind::Legal, domain::Operation::CurrencyExchange));
+static_assert(!isOperationAllowed(domain::CustomerKind::NotClient, domain::Operation::BalanceInquiry));
+static_assert(isOperationAllowed(domain::CustomerKind::VipLegal, domain::Operation::CurrencyExchange));
 
 /**
- * @brief 去除行末换行符 / Удаление символов перевода строки в конце строки
- * 
- * 去除 fgets 读取的行末 \n/\r，保证后续解析稳定。
- * Удаляет \n/\r в конце строки, прочитанной fgets, для стабильности последующего парсинга.
+ * @brief 写出事件时间前缀 / Запись префикса времени события
  * 
- * @param line 待处理的字符串 / Обрабатываемая строка
+ * 所有响应与日志行共享 "%llu # %llu:%llu # " 前缀。
+ * Все строки ответов и журнала начинаются с префикса "%llu # %llu:%llu # ".
  */
-void trimLine(std::string& line) {
-    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
-        line.pop_back();
-    }
+io::OutputSink& stamp(io::OutputSink& sink,
+                      unsigned long long day,
+                      unsigned long long hour,
+                      unsigned long long minute) {
+    return sink.number(day).text(" # ").number(hour).put(':').number(minute).text(" # ");
+}
+
+/// 操作名之后的参数 "# ..."，不拷贝 / Аргументы "# ..." после имени операции, без копирования
+io::FieldReader operationArguments(domain::Operation kind, std::string_view line) {
+    const auto name = kind == domain::Operation::Unknown ? std::size_t{0} : std::strlen(domain::toString(kind));
+    return io::FieldReader(line.substr(std::min(name, line.size())));
+}
+
+/// "%llu.%llu"，小数部分可省略 / "%llu.%llu", дробная часть необязательна
+bool readAmount(io::FieldReader& fields, domain::Money& amount) {
+    unsigned long long major{};
+    unsigned long long minor{};
+    if (!fields.readUnsigned(major)) return false;
+    if (fields.literal('.') && !fields.readUnsigned(minor)) return false;
+    amount = domain::parseMoneyParts(major, minor);
+    return true;
 }
 
 /**
- * @brief 将货币类型映射到数组下标 / Преобразование типа валюты в индекс массива
+ * @brief 在输入片段上逐行遍历来访的操作 / Построчный обход операций обращения по фрагменту ввода
  * 
- * 由于只涉及 4 种货币，用下标 0~3 直接索引计数数组能换取更好的性能。
- * RUB -> 0, YUAN -> 1, USD -> 2, EUR -> 3
- * 
- * Поскольку задействовано только 4 валюты, использование индексов 0~3 для
- * прямого индексирования массива подсчёта даёт лучшую производительность.
- * RUB -> 0, YUAN -> 1, USD -> 2, EUR -> 3
- * 
- * @param currency 货币类型 / Тип валюты
- * @return 数组下标（0-3），无效货币返回 -1 / Индекс массива (0-3), -1 для недопустимой валюты
+ * fn(kind, line) 返回 false 时停止。/ Останавливается, когда fn(kind, line) возвращает false.
  */
-int currencyIndex(domain::Currency currency) {
-    switch (currency) {
-        case domain::Currency::RUB: return 0;
-        case domain::Currency::YUAN: return 1;
-        case domain::Currency::USD: return 2;
-        case domain::Currency::EUR: return 3;
-        default: return -1;
+template <typename Fn>
+void forEachOperation(std::string_view operations, std::size_t count, Fn&& fn) {
+    io::LineCursor lines(operations);
+    std::string_view line;
+    for (std::size_t i = 0; i < count && lines.next(line); ++i) {
+        if (!fn(domain::parseOperation(line), line)) return;
     }
 }
 
@@ -86,23 +109,81 @@ int currencyIndex(domain::Currency currency) {
  算法框架固定：循环读取+错误处理的框架不变
 具体步骤可变：每种数据类型有不同的解析逻辑
 代码复用：避免在每个readXXX函数中重复循环代
+ 返回成功解析的行数，调用方据此报告失败行。
  */
 template <typename Fn>
-void repeatRead(unsigned long long count, Fn &&fn) {
-    for (unsigned long long i = 0; i < count; ++i) {
-        if (!fn(i)) {
-            std::fprintf(stderr, "Failed to read entry %llu\n", i);
-            std::exit(EXIT_FAILURE);
-        }
+unsigned long long repeatRead(const io::Section& section, Fn &&fn) {
+    io::LineCursor rows(section.body);
+    std::string_view line;
+    unsigned long long parsed = 0;
+    while (parsed < section.count && rows.nextNonBlank(line)) {
+        io::FieldReader row(line);
+        if (!fn(row)) break;
+        ++parsed;
     }
+    return parsed;
 }
+
+/**
+ * @brief 并行执行若干解析任务 / Параллельное выполнение задач разбора
+ *
+ * 数据量小时线程开销不划算，直接顺序执行。
+ * При малом объёме данных накладные расходы потоков не окупаются, выполняем последовательно.
+ */
+template <std::size_t N>
+void runSectionTasks(const std::array<std::function<void()>, N>& tasks, bool parallel) {
+    if (!parallel) {
+        for (const auto& task : tasks) task();
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(N - 1);
+    for (std::size_t i = 1; i < N; ++i) {
+        workers.emplace_back(tasks[i]);
+    }
+    tasks[0]();
+    for (auto& worker : workers) worker.join();
+}
+
+// 行数达到该阈值才启用并行解析 / Порог числа строк для параллельного разбора
+constexpr unsigned long long kParallelLoadThreshold = 4096;
+
+// 初始数据表按题目规定的顺序出现 / Таблицы начальных данных идут в порядке из задачи
+enum SectionIndex : std::size_t {
+    kAccountsSection,
+    kDebitsSection,
+    kCreditsSection,
+    kClientsSection,
+    kClientDebitSection,
+    kBankAccountsSection,
+    kClientCreditSection,
+    kWorkPlacesSection,
+    kExchangeRatesSection,
+    kSectionCount
+};
+
+constexpr std::array<std::string_view, kSectionCount> kSectionHeaders = {
+    "Accounts",
+    "Debits",
+    "Credits",
+    "Clients",
+    "Client Debit",
+    "Bank Accounts",
+    "Client Credit",
+    "Work Places",
+    "Exchange Rates",
+};
 }  // namespace
 
 namespace bank {
 
-BankSystem::BankSystem() = default;
+BankSystem::BankSystem() : BankSystem(stdout, stderr) {}
+
+BankSystem::BankSystem(std::FILE* out, std::FILE* log) : out_(out), log_(log) {}
+
+BankSystem::~BankSystem() { flushOutput(); }
 
-void BankSystem::loadInitialData() {
+bool BankSystem::loadInitialData(const char* inputPath) {
     /**
      * 输入部分严格按照题目给出的顺序依次出现，
      * 每个 readXxx 函数都只负责解析一种数据表。
@@ -110,76 +191,114 @@ void BankSystem::loadInitialData() {
      * Входная часть строго следует порядку, указанному в задаче,
      * каждая функция readXxx отвечает только за парсинг одной таблицы данных.
      */
-    readAccounts();         // 读取账户表 / Чтение таблицы счетов
-    readDeposits();         // 读取存款表 / Чтение таблицы депозитов
-    readLoans();            // 读取贷款表 / Чтение таблицы кредитов
-    readClients();          // 读取客户表 / Чтение таблицы клиентов
-    readClientAccounts();   // 读取客户账户关联表 / Чтение таблицы связей клиентов и счетов
-    readBankAccounts();     // 读取银行内部账户表 / Чтение таблицы внутренних банковских счетов
-    readClientDebts();      // 读取客户债务表 / Чтение таблицы долгов клиентов
-    readWorkplaces();       // 读取工作岗位表 / Чтение таблицы рабочих мест
-    readExchangeRates();    // 读取汇率表 / Чтение таблицы курсов обмена валют
+    if (!input_.open(inputPath)) {
+        std::fprintf(stderr, "Failed to open input %s\n", inputPath ? inputPath : "<stdin>");
+        return false;
+    }
+    cursor_ = io::LineCursor(input_.view());
+
+    // 1. 顺序扫描：只按行定位各表边界，不解析字段 / Последовательный проход: только границы таблиц
+    std::array<io::Section, kSectionCount> sections{};
+    unsigned long long totalRows = 0;
+    for (std::size_t i = 0; i < kSectionCount; ++i) {
+        if (!io::locateSection(cursor_, kSectionHeaders[i], sections[i])) {
+            std::fprintf(stderr, "Failed to read %.*s count\n",
+                         static_cast<int>(kSectionHeaders[i].size()), kSectionHeaders[i].data());
+            return false;
+        }
+        totalRows += sections[i].count;
+    }
+
+    // 2. 大表并行解析，各自写入互不相交的容器 / Большие таблицы разбираются параллельно в разные контейнеры
+    std::array<unsigned long long, kSectionCount> parsed{};
+    std::vector<domain::ClientAccount> debitRelations;
+    std::vector<domain::ClientAccount> creditRelations;
+    const std::array<std::function<void()>, 6> tasks = {
+        [&] { parsed[kAccountsSection] = readAccounts(sections[kAccountsSection]); },
+        [&] { parsed[kDebitsSection] = readDeposits(sections[kDebitsSection]); },
+        [&] { parsed[kCreditsSection] = readLoans(sections[kCreditsSection]); },
+        [&] { parsed[kClientsSection] = readClients(sections[kClientsSection]); },
+        [&] { parsed[kClientDebitSection] = readClientAccounts(sections[kClientDebitSection], debitRelations); },
+        [&] { parsed[kClientCreditSection] = readClientDebts(sections[kClientCreditSection], creditRelations); },
+    };
+    runSectionTasks(tasks, parallelLoad_ && totalRows >= kParallelLoadThreshold);
+
+    // 3. 依赖账户表的小表在汇合后顺序解析 / Малые таблицы, зависящие от счетов, разбираются после слияния
+    parsed[kBankAccountsSection] = readBankAccounts(sections[kBankAccountsSection]);
+    parsed[kWorkPlacesSection] = readWorkplaces(sections[kWorkPlacesSection]);
+    parsed[kExchangeRatesSection] = readExchangeRates(sections[kExchangeRatesSection]);
+    for (std::size_t i = 0; i < kSectionCount; ++i) {
+        if (parsed[i] < sections[i].count) {
+            std::fprintf(stderr, "Failed to read entry %llu\n", parsed[i]);
+            return false;
+        }
+    }
+
+    // 客户关联保持原有顺序：先 Client Debit，再 Client Credit。
+    for (const auto& rel : debitRelations) clientAccounts_[rel.clientId].push_back(rel);
+    for (const auto& rel : creditRelations) clientAccounts_[rel.clientId].push_back(rel);
+
     buildDerivedState();    // 构建派生状态（索引、映射等）/ Построение производного состояния (индексы, карты и т.д.)
+    return true;
 }
 
-void BankSystem::run() {
+bool BankSystem::run() {
     char buffer[kLineBuffer];
-    while (std::fgets(buffer, sizeof(buffer), stdin)) {
-        if (std::strlen(buffer) < 5) continue; 
+    std::string_view line;
+    while (!halted_ && cursor_.next(line)) {
+        // 与 fgets 一致：过短的行（含换行不足 5 个字符）直接跳过。
+        if (line.size() < 4) continue;
+        const auto length = std::min(line.size(), kLineBuffer - 1);
+        std::memcpy(buffer, line.data(), length);
+        buffer[length] = '\0';
         processEvent(buffer);
+        if (queryService_ && queryService_->due()) publishSnapshot();
     }
+    flushAppealBatch();
+    flushOutput();
+    if (queryService_) publishSnapshot(true);
+    return !halted_;
 }
 
-void BankSystem::readAccounts() {
+unsigned long long BankSystem::readAccounts(const io::Section& section) {
     // “Accounts %llu” 表头 + count 行记录。
-    unsigned long long count{};
-    if (std::scanf("Accounts %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Accounts count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    accounts_.reserve(section.count);
+    return repeatRead(section, [this](io::FieldReader& row) {
         unsigned long long id{};
-        char type[domain::kMaxString]{};
+        std::string_view type;
         unsigned long long major{};
         unsigned long long minor{};
-        char currency[domain::kMaxString]{};
-        if (std::scanf("%llu # %99[a-zA-Z0-9/_ ] # %llu.%llu # %99[a-zA-Z0-9/_ ]\n",
-                       &id,
-                       type,
-                       &major,
-                       &minor,
-                       currency) != 5) {
+        std::string_view currency;
+        if (!row.readUnsigned(id) || !row.separator() ||
+            !row.readText(type) || !row.separator() ||
+            !row.readMoney(major, minor) || !row.separator() ||
+            !row.readText(currency)) {
             return false;
         }
-        domain::Account account{};
-        account.id = id;
-        account.type = type;
-        account.balance = domain::parseMoneyParts(major, minor);
-        account.currency = currency;
-        accounts_.emplace(id, std::move(account));
+        AccountRow entry{};
+        entry.account.id = id;
+        entry.account.type = domain::parseAccountKind(type);
+        entry.account.balance = domain::parseMoneyParts(major, minor);
+        entry.account.currency = domain::parseCurrency(currency);
+        accounts_.emplace(id, std::move(entry));
         return true;
     });
 }
 
-void BankSystem::readDeposits() {
+unsigned long long BankSystem::readDeposits(const io::Section& section) {
     // “Debits” 对应存款列表：包含利率、类型、创建日期与期限。
-    unsigned long long count{};
-    if (std::scanf("Debits %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Debits count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    deposits_.reserve(section.count);
+    return repeatRead(section, [this](io::FieldReader& row) {
         unsigned long long id{};
         double rate{};
-        char type[domain::kMaxString]{};
+        std::string_view type;
         unsigned long long created{};
         unsigned long long duration{};
-        if (std::scanf("%llu # %le # %99[a-zA-Z0-9/_ ] # %llu # %llu\n",
-                       &id,
-                       &rate,
-                       type,
-                       &created,
-                       &duration) != 5) {
+        if (!row.readUnsigned(id) || !row.separator() ||
+            !row.readDouble(rate) || !row.separator() ||
+            !row.readText(type) || !row.separator() ||
+            !row.readUnsigned(created) || !row.separator() ||
+            !row.readUnsigned(duration)) {
             return false;
         }
         domain::Deposit deposit{};
@@ -193,25 +312,19 @@ void BankSystem::readDeposits() {
     });
 }
 
-void BankSystem::readLoans() {
+unsigned long long BankSystem::readLoans(const io::Section& section) {
     // “Credits” 对应贷款列表。
-    unsigned long long count{};
-    if (std::scanf("Credits %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Credits count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    loans_.reserve(section.count);
+    return repeatRead(section, [this](io::FieldReader& row) {
         unsigned long long id{};
         double rate{};
         unsigned long long major{};
         unsigned long long minor{};
-        char type[domain::kMaxString]{};
-        if (std::scanf("%llu # %le # %llu.%llu # %99[a-zA-Z0-9/_ ]\n",
-                       &id,
-                       &rate,
-                       &major,
-                       &minor,
-                       type) != 5) {
+        std::string_view type;
+        if (!row.readUnsigned(id) || !row.separator() ||
+            !row.readDouble(rate) || !row.separator() ||
+            !row.readMoney(major, minor) || !row.separator() ||
+            !row.readText(type)) {
             return false;
         }
         domain::Loan loan{};
@@ -224,44 +337,38 @@ void BankSystem::readLoans() {
     });
 }
 
-void BankSystem::readClients() {
+unsigned long long BankSystem::readClients(const io::Section& section) {
     // 客户主数据：ID + 姓名 + 类型。
-    unsigned long long count{};
-    if (std::scanf("Clients %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Clients count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    clients_.reserve(section.count);
+    return repeatRead(section, [this](io::FieldReader& row) {
         unsigned long long id{};
-        char name[domain::kMaxString]{};
-        char type[domain::kMaxString]{};
-        if (std::scanf("%llu # %99[a-zA-Z0-9/_ ] # %99[a-zA-Z0-9/_ ]\n",
-                       &id,
-                       name,
-                       type) != 3) {
+        std::string_view name;
+        std::string_view type;
+        if (!row.readUnsigned(id) || !row.separator() ||
+            !row.readText(name) || !row.separator() ||
+            !row.readText(type)) {
             return false;
         }
-        domain::Client client{};
-        client.id = id;
-        client.name = name;
-        client.type = type;
-        clients_.emplace(id, std::move(client));
+        ClientRow entry(&nodePool_);
+        entry.client.id = id;
+        entry.client.name = name;
+        entry.client.type = domain::parseCustomerKind(type);
+        clients_.emplace(id, std::move(entry));
         return true;
     });
 }
 
-void BankSystem::readClientAccounts() {
+unsigned long long BankSystem::readClientAccounts(const io::Section& section,
+                                                  std::vector<domain::ClientAccount>& relations) {
     // “Client Debit” 建立客户与账户/存款的映射。
-    unsigned long long count{};
-    if (std::scanf("Client Debit %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Client Debit count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    relations.reserve(section.count);
+    return repeatRead(section, [&relations](io::FieldReader& row) {
         unsigned long long clientId{};
         unsigned long long accountId{};
         unsigned long long depositId{};
-        if (std::scanf("%llu # %llu # %llu\n", &clientId, &accountId, &depositId) != 3) {
+        if (!row.readUnsigned(clientId) || !row.separator() ||
+            !row.readUnsigned(accountId) || !row.separator() ||
+            !row.readUnsigned(depositId)) {
             return false;
         }
         domain::ClientAccount rel{};
@@ -269,45 +376,40 @@ void BankSystem::readClientAccounts() {
         rel.accountId = accountId;
         rel.depositId = depositId;
         rel.isDepositAccount = depositId != 0;
-        clientAccounts_[clientId].push_back(rel);
+        relations.push_back(rel);
         return true;
     });
 }
 
-void BankSystem::readBankAccounts() {
+unsigned long long BankSystem::readBankAccounts(const io::Section& section) {
     // 每个币种对应一个银行内部账户，保存手续费/利息。
-    unsigned long long count{};
-    if (std::scanf("Bank Accounts %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Bank Accounts count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    return repeatRead(section, [this](io::FieldReader& row) {
         unsigned long long accountId{};
-        if (std::scanf("%llu\n", &accountId) != 1) {
+        if (!row.readUnsigned(accountId)) {
             return false;
         }
-        auto it = accounts_.find(accountId);
-        if (it == accounts_.end()) {
+        const auto* entry = accounts_.find(accountId);
+        if (!entry) {
             std::fprintf(stderr, "Unknown bank internal account %llu\n", accountId);
             return false;
         }
-        bankInternalAccounts_[it->second.currency] = accountId;
+        const auto idx = domain::currencyIndex(entry->account.currency);
+        if (idx >= 0) bankInternalAccounts_[static_cast<std::size_t>(idx)] = accountId;
         return true;
     });
 }
 
-void BankSystem::readClientDebts() {
+unsigned long long BankSystem::readClientDebts(const io::Section& section,
+                                               std::vector<domain::ClientAccount>& relations) {
     // “Client Credit” 建立客户与贷款账户之间的关系。
-    unsigned long long count{};
-    if (std::scanf("Client Credit %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Client Credit count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
+    relations.reserve(section.count);
+    return repeatRead(section, [&relations](io::FieldReader& row) {
         unsigned long long clientId{};
         unsigned long long accountId{};
         unsigned long long loanId{};
-        if (std::scanf("%llu # %llu # %llu\n", &clientId, &accountId, &loanId) != 3) {
+        if (!row.readUnsigned(clientId) || !row.separator() ||
+            !row.readUnsigned(accountId) || !row.separator() ||
+            !row.readUnsigned(loanId)) {
             return false;
         }
         domain::ClientAccount rel{};
@@ -315,128 +417,141 @@ void BankSystem::readClientDebts() {
         rel.accountId = accountId;
         rel.loanId = loanId;
         rel.isLoanAccount = loanId != 0;
-        clientAccounts_[clientId].push_back(rel);
+        relations.push_back(rel);
         return true;
     });
 }
 
-void BankSystem::readWorkplaces() {
+unsigned long long BankSystem::readWorkplaces(const io::Section& section) {
     // 记录各个岗位的数量，未来用于排队/统计。
-    unsigned long long count{};
-    if (std::scanf("Work Places %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Work Places count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
-        char type[domain::kMaxString]{};
+    workplaces_.reserve(section.count);
+    return repeatRead(section, [this](io::FieldReader& row) {
+        std::string_view type;
         unsigned long long amount{};
-        if (std::scanf("%99[a-zA-Z0-9/_ ] # %llu\n", type, &amount) != 2) {
+        if (!row.readText(type) || !row.separator() || !row.readUnsigned(amount)) {
             return false;
         }
         domain::WorkplaceDefinition def{};
-        def.type = type;
+        def.type = domain::parseWorkplaceKind(type);
         def.count = amount;
         workplaces_.push_back(def);
         return true;
     });
 }
 
-void BankSystem::readExchangeRates() {
-    // 货币兑换比率，稍后可用于兑换/跨币种操作。
-    unsigned long long count{};
-    if (std::scanf("Exchange Rates %llu\n", &count) != 1) {
-        std::fprintf(stderr, "Failed to read Exchange Rates count\n");
-        std::exit(EXIT_FAILURE);
-    }
-    repeatRead(count, [this](unsigned long long) {
-        char fromCur[domain::kMaxString]{};
-        char toCur[domain::kMaxString]{};
+unsigned long long BankSystem::readExchangeRates(const io::Section& section) {
+    // 货币兑换报价；完整的汇率矩阵在 buildDerivedState 中构建。
+    return repeatRead(section, [this](io::FieldReader& row) {
+        std::string_view fromCur;
+        std::string_view toCur;
         double ratio{};
-        if (std::scanf("%99[a-zA-Z0-9/_ ] # %99[a-zA-Z0-9/_ ] # %le\n",
-                       fromCur,
-                       toCur,
-                       &ratio) != 3) {
+        if (!row.readText(fromCur) || !row.separator() ||
+            !row.readText(toCur) || !row.separator() ||
+            !row.readDouble(ratio)) {
             return false;
         }
-        exchangeRates_.emplace(std::make_pair(std::string(fromCur), std::string(toCur)), ratio);
+        exchangeRates_.push_back({domain::parseCurrency(fromCur), domain::parseCurrency(toCur), ratio});
         return true;
     });
 }
 
 void BankSystem::buildDerivedState() {
     // nextAccountId_/nextClientId_ 用于生成新的实体编号。
-    nextAccountId_ = 1;
-    for (const auto& [id, _] : accounts_) {
-        nextAccountId_ = std::max(nextAccountId_, id + 1);
-    }
-    nextClientId_ = 1;
-    for (const auto& [id, client] : clients_) {
-        nextClientId_ = std::max(nextClientId_, id + 1);
-        clientNameToId_[client.name] = id;
-        accountCountByCurrency_[id];
+    nextAccountId_ = accounts_.empty() ? 1 : std::max<unsigned long long>(1, accounts_.maxId() + 1);
+    nextClientId_ = clients_.empty() ? 1 : std::max<unsigned long long>(1, clients_.maxId() + 1);
+    scheduler_.configure(workplaces_);
+    rates_ = domain::buildRateMatrix(exchangeRates_);
+    std::vector<std::pair<std::string_view, unsigned long long>> names;
+    names.reserve(clients_.size());
+    clients_.forEach([&names](unsigned long long id, ClientRow& row) {
+        names.emplace_back(row.client.name, id);
+        row.activeAccounts = {};
+    });
+    clientNameToId_.build(names);
+
+    // 所有者与产品标记直接写入账户行。
+    for (const auto& [clientId, relations] : clientAccounts_) {
+        for (const auto& rel : relations) {
+            auto* accountRow = accounts_.find(rel.accountId);
+            if (!accountRow) continue;
+            accountRow->owner = clientId;
+            accountRow->hasOwner = true;
+            if (rel.isDepositAccount) {
+                accountRow->product = Product::Deposit;
+                if (const auto* deposit = deposits_.find(rel.depositId); deposit && deposit->durationDays > 0) {
+                    accountRow->maturesOn = deposit->createdDay + deposit->durationDays;
+                }
+            }
+            if (rel.isLoanAccount) {
+                accountRow->product = Product::Loan;
+                if (const auto* loan = loans_.find(rel.loanId)) accountRow->loanAmount = loan->amount;
+            }
+        }
     }
 
-    accountOwners_.clear();
-    accountCountByCurrency_.clear();
+    // 活跃账户按账号顺序进入所有者的按币种索引 / Активные счета попадают в индекс владельца в порядке номеров
+    accounts_.forEach([this](unsigned long long, AccountRow& row) {
+        if (!row.hasOwner || !row.account.active) return;
+        if (auto* clientRow = clients_.find(row.owner)) indexAccount(*clientRow, row);
+    });
+
+    // 计息账本：只登记关联到现有账户的存款与贷款 / Книги начисления: только продукты, привязанные к существующим счетам
+    interest_.clear();
     for (const auto& [clientId, relations] : clientAccounts_) {
         for (const auto& rel : relations) {
-            accountOwners_[rel.accountId] = clientId;
-            auto accountIt = accounts_.find(rel.accountId);
-            if (accountIt == accounts_.end()) continue;
-            auto currency = domain::parseCurrency(accountIt->second.currency);
-            const auto idx = currencyIndex(currency);
-            if (idx >= 0) {
-                accountCountByCurrency_[clientId][idx]++;
+            if (!accounts_.contains(rel.accountId)) continue;
+            if (rel.isDepositAccount) {
+                if (const auto* deposit = deposits_.find(rel.depositId)) interest_.addDeposit(rel.accountId, *deposit);
+            }
+            if (rel.isLoanAccount) {
+                if (const auto* loan = loans_.find(rel.loanId)) interest_.addLoan(rel.accountId, *loan);
             }
         }
     }
+    interest_.finalize();
 }
 
-domain::Client* BankSystem::findClientByName(const std::string& name) {
-    auto it = clientNameToId_.find(name);
-    if (it == clientNameToId_.end()) return nullptr;
-    auto clientIt = clients_.find(it->second);
-    if (clientIt == clients_.end()) return nullptr;
-    return &clientIt->second;
+domain::Client* BankSystem::findClientByName(std::string_view name) {
+    const auto* id = clientNameToId_.find(name);
+    if (!id) return nullptr;
+    auto* row = clients_.find(*id);
+    return row ? &row->client : nullptr;
 }
 
 //工厂方法模式 (Factory Method Pattern):根据客户类型创建客户对象。
-domain::Client* BankSystem::ensureClientByName(const std::string& name, domain::CustomerKind fallbackType) {
+domain::Client* BankSystem::ensureClientByName(std::string_view name, domain::CustomerKind fallbackType) {
     // 若客户不存在，则在 Personal Appeal 环节即时创建（仅允许特定业务）。
     if (auto existing = findClientByName(name)) {
         return existing;
     }
-    domain::Client client{};
-    client.id = nextClientId_++;
-    client.name = name;
-    client.type = domain::toString(fallbackType);
-    auto [it, inserted] = clients_.emplace(client.id, std::move(client));
+    ClientRow row(&nodePool_);
+    row.client.id = nextClientId_++;
+    row.client.name = name;
+    row.client.type = fallbackType;
+    auto [created, inserted] = clients_.emplace(row.client.id, std::move(row));
     (void)inserted;
-    clientNameToId_[name] = it->second.id;
-    accountCountByCurrency_[it->second.id];
-    return &it->second;
+    clientNameToId_.insert(name, created->client.id);
+    if (journal_.active()) journal_.newClient(created->client.id, fallbackType, name);
+    return &created->client;
 }
 
 const domain::Account* BankSystem::findAccount(unsigned long long accountId) const {
-    auto it = accounts_.find(accountId);
-    if (it == accounts_.end()) return nullptr;
-    return &it->second;
+    const auto* row = accounts_.find(accountId);
+    return row ? &row->account : nullptr;
 }
 
 domain::Account* BankSystem::findAccount(unsigned long long accountId) {
-    auto it = accounts_.find(accountId);
-    if (it == accounts_.end()) return nullptr;
-    return &it->second;
+    auto* row = accounts_.find(accountId);
+    return row ? &row->account : nullptr;
 }
 
 bool BankSystem::accountBelongsToClient(unsigned long long clientId, unsigned long long accountId) const {
-    auto it = accountOwners_.find(accountId);
-    if (it == accountOwners_.end()) return false;
-    return it->second == clientId;
+    const auto* row = accounts_.find(accountId);
+    return row && row->hasOwner && row->owner == clientId;
 }
 
 domain::CustomerKind BankSystem::clientKind(const domain::Client& client) const {
-    return domain::parseCustomerKind(client.type);
+    return client.type;
 }
 
 // 命令模式，将事件处理委托给具体的命令对象。
@@ -446,10 +561,18 @@ void BankSystem::processEvent(const char* buffer) {
     unsigned long long minute{};
     char payload[kLineBuffer]{};
     if (std::sscanf(buffer, "%llu # %llu:%llu # %255[^\n]\n", &day, &hour, &minute, payload) != 4) {
-        std::fprintf(stderr, "Unsupported event: %s", buffer);
+        flushAppealBatch();
+        log_.text("Unsupported event: ").text(buffer).put('\n');
         return;
     }
 
+    if (std::strncmp(payload, "Personal Appeal", 15) == 0) {
+        handlePersonalAppeal(day, hour, minute, payload);
+        return;
+    }
+    // 其他事件之前先结算积压的来访，保证输出顺序 / Перед другими событиями выполняем накопленные обращения
+    flushAppealBatch();
+    if (halted_) return;
     if (std::strncmp(payload, "Start of Bank Day", 17) == 0) {
         handleStartOfDay(day, hour, minute);
         return;
@@ -458,100 +581,59 @@ void BankSystem::processEvent(const char* buffer) {
         handleEndOfDay(day, hour, minute);
         return;
     }
-    if (std::strncmp(payload, "Personal Appeal", 15) == 0) {
-        handlePersonalAppeal(day, hour, minute, payload);
-        return;
-    }
 
     // TODO: implement remaining event handlers following the specification
 }
 
-// 工厂方法模式 (Factory Method Pattern):根据事件类型创建事件对象。
-void BankSystem::handlePersonalAppeal(unsigned long long day,
-                                      unsigned long long hour,
-                                      unsigned long long minute,
-                                      const char* payload) {
+const char* BankSystem::readAppeal(const char* payload, AppealRequest& request) {
     // Personal Appeal 消息第一行包含客户姓名、类型标识与操作数量。
     // 随后的 N 行是真正的操作描述（例如 Balance Inquiry / Create Account）。
-    char name[domain::kMaxString]{};
     char typeToken[domain::kMaxString]{};
     unsigned long long operationCount{};
     if (std::sscanf(payload,
                     "Personal Appeal # %99[a-zA-Z0-9/_ ] # %99[a-zA-Z0-9/_ ] # %llu",
-                    name,
+                    request.name.data(),
                     typeToken,
                     &operationCount) != 3) {
-        logError("Malformed Personal Appeal");
-        return;
+        return "Malformed Personal Appeal";
     }
+    request.token = domain::parseClientToken(typeToken);
 
-    std::vector<std::string> operations;
-    operations.reserve(operationCount);
+    // 预扫描：只确定片段边界与新客户能否办理 / Предпросмотр: только границы фрагмента и допуск нового клиента
+    const auto begin = cursor_.offset();
     for (unsigned long long i = 0; i < operationCount; ++i) {
-        char opLine[kLineBuffer]{};
-        if (!std::fgets(opLine, sizeof(opLine), stdin)) {
-            logError("Unexpected end of input while reading operations");
-            return;
+        std::string_view opLine;
+        if (!cursor_.next(opLine)) {
+            return "Unexpected end of input while reading operations";
         }
-        std::string opString(opLine);
-        trimLine(opString);
-        operations.emplace_back(std::move(opString));
+        const auto kind = domain::parseOperation(opLine);
+        request.opensAccount = request.opensAccount || kind == domain::Operation::CreateAccount ||
+                               kind == domain::Operation::RequestDebitCard;
     }
+    request.operations = cursor_.slice(begin, cursor_.offset());
+    request.operationCount = static_cast<std::size_t>(operationCount);
+    return nullptr;
+}
 
-    std::string nameStr(name);
-    domain::Client* client = findClientByName(nameStr);
-    domain::CustomerKind kind = domain::CustomerKind::NotClient;
+// 工厂方法模式 (Factory Method Pattern):根据事件类型创建事件对象。
+void BankSystem::handlePersonalAppeal(unsigned long long day,
+                                      unsigned long long hour,
+                                      unsigned long long minute,
+                                      const char* payload) {
+    AppealRequest request{};
+    request.day = day;
+    request.hour = hour;
+    request.minute = minute;
+    request.error = readAppeal(payload, request);
 
-    if (client) {
-        kind = clientKind(*client);
-    } else {
-        kind = domain::parseClientToken(typeToken);
-        if (kind == domain::CustomerKind::NotClient) {
-            std::printf("%llu # %llu:%llu # Client error. Wrong operation for new client\n", day, hour, minute);
-            return;
-        }
-        bool allowed = false;
-        for (const auto& op : operations) {
-            if (op.rfind("Create Account", 0) == 0 || op.rfind("Request Debit Card", 0) == 0) {
-                allowed = true;
-                break;
-            }
-        }
-        if (!allowed) {
-            std::printf("%llu # %llu:%llu # Client error. Wrong operation for new client\n", day, hour, minute);
-            return;
-        }
-        client = ensureClientByName(nameStr, kind);
+    // 分片模式：积压到下一个非来访事件再并行执行 / Шардирование: копим до следующего события другого типа
+    if (appealPool_) {
+        appealBatch_.push_back(std::move(request));
+        return;
     }
 
-    // 逐条处理客户请求：未实现的操作统一返回“Service not available”。
-    for (const auto& operation : operations) {
-        if (operation.rfind("Balance Inquiry", 0) == 0) {
-            unsigned long long accountId{};
-            if (std::sscanf(operation.c_str(), "Balance Inquiry # %llu", &accountId) != 1) {
-                std::printf("%llu # %llu:%llu # Client error. Unknown account\n", day, hour, minute);
-                continue;
-            }
-            if (!isOperationAllowed(kind, "Balance Inquiry")) {
-                std::printf("%llu # %llu:%llu # Service not available\n", day, hour, minute);
-                continue;
-            }
-            handleBalanceInquiry(*client, accountId, day, hour, minute);
-        } else if (operation.rfind("Create Account", 0) == 0) {
-            char currency[domain::kMaxString]{};
-            if (std::sscanf(operation.c_str(), "Create Account # %99[a-zA-Z0-9/_ ]", currency) != 1) {
-                std::printf("%llu # %llu:%llu # Client error. Unknown currency\n", day, hour, minute);
-                continue;
-            }
-            if (!isOperationAllowed(kind, "Create Account")) {
-                std::printf("%llu # %llu:%llu # Service not available\n", day, hour, minute);
-                continue;
-            }
-            handleCreateAccount(*client, kind, currency, day, hour, minute);
-        } else {
-            std::printf("%llu # %llu:%llu # Service not available\n", day, hour, minute);
-        }
-    }
+    // 顺序模式：逐行执行并立即提交 / Последовательный режим: построчное выполнение и сразу фиксация
+    processAppeal(request, admitAppeal(request));
 }
 
 void BankSystem::handleStartOfDay(unsigned long long day,
@@ -560,6 +642,9 @@ void BankSystem::handleStartOfDay(unsigned long long day,
     currentTime_ = {day, 8, 0};
     bankDayStarted_ = true;
     bankDayClosed_ = false;
+    dayStats_ = DayStats{};
+    dayStats_.day = day;
+    scheduler_.startDay();
     (void)hour;
     (void)minute;
 }
@@ -577,176 +662,1317 @@ void BankSystem::handleEndOfDay(unsigned long long day,
     currentTime_.hour = 19;
     currentTime_.minute = 0;
     bankDayClosed_ = true;
-}
 
-void BankSystem::handleBalanceInquiry(domain::Client& client,
-                                      unsigned long long accountId,
-                                      unsigned long long day,
-                                      unsigned long long hour,
-                                      unsigned long long minute) {
-    (void)client;
-    auto account = findAccount(accountId);
-    if (!account) {
-        std::printf("%llu # %llu:%llu # Client error. Unknown account\n", day, hour, minute);
-        return;
+    accrueInterest(day, AccrualPeriod::Daily);
+    if (halted_) return;
+
+    // 各工作岗位当天服务的客户数："%llu # %s # %llu # %llu"，岗位序号从 1 开始
+    // Число обслуженных клиентов по местам: "%llu # %s # %llu # %llu", номера мест с 1
+    auto report = scheduler_.finishDay();
+    std::array<std::size_t, domain::kWorkplaceKindCount> reported{};
+    for (const auto& def : workplaces_) {
+        if (def.type == domain::WorkplaceKind::Unknown) continue;
+        const auto kindIdx = static_cast<std::size_t>(def.type);
+        for (unsigned long long i = 0; i < def.count; ++i) {
+            const auto instance = reported[kindIdx]++;
+            out_.number(day).text(" # ").text(domain::toString(def.type)).text(" # ").number(instance + 1)
+                .text(" # ").number(report.served[kindIdx][instance]).put('\n');
+        }
     }
-    // 权限校验：题目要求只能查询属于自己的账户。
-    auto owner = accountOwners_.find(accountId);
-    if (owner == accountOwners_.end() || owner->second != client.id) {
-        std::printf("%llu # %llu:%llu # Client error. Access denied\n", day, hour, minute);
-        return;
+    dayStats_.customers = report.customers;
+    dayStats_.turnedAway = report.turnedAway;
+    dayStats_.waitHistogram = std::move(report.waitHistogram);
+    dailyStats_.push_back(dayStats_);
+#if BANK_PROFILE
+    if (profile_) {
+        profiler_.report(day, *profile_);
+    } else {
+        profiler_.clear();
     }
-    auto fmt = domain::formatMoney(account->balance);
-    std::printf("%llu # %llu:%llu # Balance of %llu # %s%llu.%03llu\n",
-                day,
-                hour,
-                minute,
-                accountId,
-                fmt.negative ? "-" : "",
-                fmt.major,
-                fmt.minor);
+#endif
+    if (queryService_) publishSnapshot();
+    if (columnar_.recording()) exportColumns(day);
+    // 当天的批次对象都已销毁 / Все объекты пакетов этого дня уже уничтожены
+    dayArena_.release();
+    // 营业日结束是显式的刷新点 / Конец банковского дня - явная точка сброса буферов
+    flushOutput();
+    if (journal_.active()) commitJournalDay(day);
 }
 
-//  策略模式 (Strategy Pattern)：根据客户类型和货币类型，选择不同的开户费率。
-static double accountOpeningFee(domain::CustomerKind kind, domain::Currency currency) {
-    struct Rule {
-        domain::CustomerKind kind;
-        domain::Currency currency;
-        double fee;
-    };
+namespace {
+/**
+ * @brief 按 (客户类型, 币种) 直接索引的费率/限额表 / Таблицы тарифов/лимитов с индексом (тип клиента, валюта)
+ * 
+ * 规则仍按题目表格逐条列出，编译期展开为二维数组；static_assert 保证
+ * 每个格子恰好定义一次，因此运行时查表不需要任何比较。
+ * 
+ * Правила по-прежнему перечислены построчно, как в таблице задачи, и на этапе
+ * компиляции разворачиваются в двумерный массив; static_assert гарантирует, что
+ * каждая ячейка задана ровно один раз, поэтому поиск во время выполнения без сравнений.
+ */
+template <typename Value>
+struct TariffRule {
+    domain::CustomerKind kind;
+    domain::Currency currency;
+    Value value;
+};
 
-    static const Rule rules[] = {
-        {domain::CustomerKind::Individual, domain::Currency::RUB, 10000.0},
-        {domain::CustomerKind::VipIndividual, domain::Currency::RUB, 4000.0},
-        {domain::CustomerKind::Legal, domain::Currency::RUB, 25000.0},
-        {domain::CustomerKind::VipLegal, domain::Currency::RUB, 15000.0},
-        {domain::CustomerKind::Individual, domain::Currency::YUAN, 2000.0},
-        {domain::CustomerKind::VipIndividual, domain::Currency::YUAN, 1000.0},
-        {domain::CustomerKind::Legal, domain::Currency::YUAN, 5000.0},
-        {domain::CustomerKind::VipLegal, domain::Currency::YUAN, 2000.0},
-        {domain::CustomerKind::Individual, domain::Currency::USD, 100.0},
-        {domain::CustomerKind::VipIndividual, domain::Currency::USD, 50.0},
-        {domain::CustomerKind::Legal, domain::Currency::USD, 200.0},
-        {domain::CustomerKind::VipLegal, domain::Currency::USD, 100.0},
-        {domain::CustomerKind::Individual, domain::Currency::EUR, 100.0},
-        {domain::CustomerKind::VipIndividual, domain::Currency::EUR, 50.0},
-        {domain::CustomerKind::Legal, domain::Currency::EUR, 200.0},
-        {domain::CustomerKind::VipLegal, domain::Currency::EUR, 100.0},
-    };
+template <typename Value>
+using TariffTable = std::array<std::array<Value, domain::kCurrencyCount>, domain::kCustomerKindCount>;
 
+template <typename Value, std::size_t N>
+constexpr TariffTable<Value> buildTariffTable(const std::array<TariffRule<Value>, N>& rules) {
+    TariffTable<Value> table{};
     for (const auto& rule : rules) {
-        if (rule.kind == kind && rule.currency == currency) return rule.fee;
+        table[static_cast<std::size_t>(domain::customerIndex(rule.kind))]
+             [static_cast<std::size_t>(domain::currencyIndex(rule.currency))] = rule.value;
     }
-    return 0.0;
+    return table;
 }
 
+// 每个 (客户类型, 币种) 恰好出现一次 / Каждая пара (тип клиента, валюта) встречается ровно один раз
+template <typename Value, std::size_t N>
+constexpr bool coversEveryCell(const std::array<TariffRule<Value>, N>& rules) {
+    std::array<std::array<int, domain::kCurrencyCount>, domain::kCustomerKindCount> seen{};
+    for (const auto& rule : rules) {
+        const auto kindIdx = domain::customerIndex(rule.kind);
+        const auto currencyIdx = domain::currencyIndex(rule.currency);
+        if (kindIdx < 0 || currencyIdx < 0) return false;
+        ++seen[static_cast<std::size_t>(kindIdx)][static_cast<std::size_t>(currencyIdx)];
+    }
+    for (const auto& row : seen) {
+        for (int count : row) {
+            if (count != 1) return false;
+        }
+    }
+    return true;
+}
+
+using domain::Currency;
+using domain::CustomerKind;
+using domain::Money;
+
+//  策略模式 (Strategy Pattern)：根据客户类型和货币类型，选择不同的开户费率。
+constexpr std::array<TariffRule<Money>, 16> kOpeningFeeRules = {{
+    {CustomerKind::Individual, Currency::RUB, Money::fromUnits(10000)},
+    {CustomerKind::VipIndividual, Currency::RUB, Money::fromUnits(4000)},
+    {CustomerKind::Legal, Currency::RUB, Money::fromUnits(25000)},
+    {CustomerKind::VipLegal, Currency::RUB, Money::fromUnits(15000)},
+    {CustomerKind::Individual, Currency::YUAN, Money::fromUnits(2000)},
+    {CustomerKind::VipIndividual, Currency::YUAN, Money::fromUnits(1000)},
+    {CustomerKind::Legal, Currency::YUAN, Money::fromUnits(5000)},
+    {CustomerKind::VipLegal, Currency::YUAN, Money::fromUnits(2000)},
+    {CustomerKind::Individual, Currency::USD, Money::fromUnits(100)},
+    {CustomerKind::VipIndividual, Currency::USD, Money::fromUnits(50)},
+    {CustomerKind::Legal, Currency::USD, Money::fromUnits(200)},
+    {CustomerKind::VipLegal, Currency::USD, Money::fromUnits(100)},
+    {CustomerKind::Individual, Currency::EUR, Money::fromUnits(100)},
+    {CustomerKind::VipIndividual, Currency::EUR, Money::fromUnits(50)},
+    {CustomerKind::Legal, Currency::EUR, Money::fromUnits(200)},
+    {CustomerKind::VipLegal, Currency::EUR, Money::fromUnits(100)},
+}};
+static_assert(coversEveryCell(kOpeningFeeRules), "opening fee table must cover every (client kind, currency)");
+constexpr auto kOpeningFees = buildTariffTable(kOpeningFeeRules);
+
 // 策略模式 (Strategy Pattern)：根据客户类型和货币类型，选择不同的账户限额。
-static unsigned int accountLimit(domain::CustomerKind kind, domain::Currency currency) {
-    struct LimitRule {
-        domain::CustomerKind kind;
-        domain::Currency currency;
-        unsigned int limit;
-    };
+constexpr std::array<TariffRule<unsigned int>, 16> kAccountLimitRules = {{
+    {CustomerKind::Individual, Currency::RUB, 3},
+    {CustomerKind::VipIndividual, Currency::RUB, 5},
+    {CustomerKind::Legal, Currency::RUB, 10},
+    {CustomerKind::VipLegal, Currency::RUB, 25},
+    {CustomerKind::Individual, Currency::YUAN, 1},
+    {CustomerKind::VipIndividual, Currency::YUAN, 5},
+    {CustomerKind::Legal, Currency::YUAN, 5},
+    {CustomerKind::VipLegal, Currency::YUAN, 15},
+    {CustomerKind::Individual, Currency::USD, 1},
+    {CustomerKind::VipIndividual, Currency::USD, 3},
+    {CustomerKind::Legal, Currency::USD, 5},
+    {CustomerKind::VipLegal, Currency::USD, 10},
+    {CustomerKind::Individual, Currency::EUR, 1},
+    {CustomerKind::VipIndividual, Currency::EUR, 3},
+    {CustomerKind::Legal, Currency::EUR, 5},
+    {CustomerKind::VipLegal, Currency::EUR, 10},
+}};
+static_assert(coversEveryCell(kAccountLimitRules), "account limit table must cover every (client kind, currency)");
+constexpr auto kAccountLimits = buildTariffTable(kAccountLimitRules);
 
-    static const LimitRule rules[] = {
-        {domain::CustomerKind::Individual, domain::Currency::RUB, 3},
-        {domain::CustomerKind::VipIndividual, domain::Currency::RUB, 5},
-        {domain::CustomerKind::Legal, domain::Currency::RUB, 10},
-        {domain::CustomerKind::VipLegal, domain::Currency::RUB, 25},
-        {domain::CustomerKind::Individual, domain::Currency::YUAN, 1},
-        {domain::CustomerKind::VipIndividual, domain::Currency::YUAN, 5},
-        {domain::CustomerKind::Legal, domain::Currency::YUAN, 5},
-        {domain::CustomerKind::VipLegal, domain::Currency::YUAN, 15},
-        {domain::CustomerKind::Individual, domain::Currency::USD, 1},
-        {domain::CustomerKind::VipIndividual, domain::Currency::USD, 3},
-        {domain::CustomerKind::Legal, domain::Currency::USD, 5},
-        {domain::CustomerKind::VipLegal, domain::Currency::USD, 10},
-        {domain::CustomerKind::Individual, domain::Currency::EUR, 1},
-        {domain::CustomerKind::VipIndividual, domain::Currency::EUR, 3},
-        {domain::CustomerKind::Legal, domain::Currency::EUR, 5},
-        {domain::CustomerKind::VipLegal, domain::Currency::EUR, 10},
-    };
+Money accountOpeningFee(CustomerKind kind, Currency currency) {
+    const auto kindIdx = domain::customerIndex(kind);
+    const auto currencyIdx = domain::currencyIndex(currency);
+    if (kindIdx < 0 || currencyIdx < 0) return {};
+    return kOpeningFees[static_cast<std::size_t>(kindIdx)][static_cast<std::size_t>(currencyIdx)];
+}
 
-    for (const auto& rule : rules) {
-        if (rule.kind == kind && rule.currency == currency) return rule.limit;
+unsigned int accountLimit(CustomerKind kind, Currency currency) {
+    const auto kindIdx = domain::customerIndex(kind);
+    const auto currencyIdx = domain::currencyIndex(currency);
+    if (kindIdx < 0 || currencyIdx < 0) return 0;
+    return kAccountLimits[static_cast<std::size_t>(kindIdx)][static_cast<std::size_t>(currencyIdx)];
+}
+}  // namespace
+
+BankSystem::Admission BankSystem::admitAppeal(const AppealRequest& request) {
+    Admission admission{};
+    if (request.error) return admission;
+
+    domain::Client* client = findClientByName(request.clientName());
+    if (client) {
+        admission.kind = clientKind(*client);
+    } else {
+        // 新客户只允许办理开户或申请借记卡 / Новому клиенту доступны только открытие счёта и дебетовая карта
+        if (request.token == domain::CustomerKind::NotClient || !request.opensAccount) return admission;
+        admission.kind = request.token;
+        admission.registered = true;
+        client = ensureClientByName(request.clientName(), request.token);
     }
-    return 0;
+    admission.clientId = client->id;
+    admission.admitted = true;
+    ++dayStats_.appeals;
+    dayStats_.operations += request.operationCount;
+    return admission;
 }
 
-void BankSystem::handleCreateAccount(domain::Client& client,
-                                     domain::CustomerKind kind,
-                                     const std::string& currencyStr,
-                                     unsigned long long day,
-                                     unsigned long long hour,
-                                     unsigned long long minute) {
-    // 1. 校验币种 + 账户数量限制
-    auto currency = domain::parseCurrency(currencyStr);
-    if (currency == domain::Currency::Unknown) {
-        std::printf("%llu # %llu:%llu # Client error. Unknown currency\n", day, hour, minute);
+void BankSystem::processAppeal(const AppealRequest& request, const Admission& admission) {
+    if (request.error) {
+        logError(request.error);
+        return;
+    }
+    if (!admission.admitted) {
+        respond(request.day, request.hour, request.minute, "Client error. Wrong operation for new client");
         return;
     }
+    scheduleAppeal(request, admission);
+    // 每个操作立即提交，效果只需在本操作内有效 / Каждая операция сразу фиксируется, эффекты нужны лишь внутри неё
+    const auto& clientRow = *clients_.find(admission.clientId);
+    forEachOperation(request.operations, request.operationCount, [&](domain::Operation kind, std::string_view line) {
+        BANK_PROFILE_SCOPE(profiler_, kind);
+        serialEffects_.clear();
+        const auto result = executeOperation(clientRow, admission, serialEffects_, kind, line);
+        scheduleOperation(admission, kind, result);
+        return commitOperation(request, admission, result);
+    });
+}
 
-    const auto allowedAccounts = accountLimit(kind, currency);
-    const auto currencyIdx = currencyIndex(currency);
+void BankSystem::executeAppeal(const AppealRequest& request,
+                               const Admission& admission,
+                               AppealEffects& effects,
+                               std::pmr::vector<OpResult>& results) const {
+    results.clear();
+    effects.clear();
+    if (request.error) {
+        results.push_back({OpResult::Kind::LogError, request.error});
+        return;
+    }
+    if (!admission.admitted) {
+        results.push_back({OpResult::Kind::Message, "Client error. Wrong operation for new client"});
+        return;
+    }
+    // 容量已由写线程预留，工作线程不触碰 dayArena_ / Ёмкость зарезервирована потоком записи, рабочие потоки не трогают dayArena_
+    const auto& clientRow = *clients_.find(admission.clientId);
+    forEachOperation(request.operations, request.operationCount, [&](domain::Operation kind, std::string_view line) {
+        auto& result = results.emplace_back();
+        {
+            BANK_PROFILE_SCOPE(result.nanos);
+            result = executeOperation(clientRow, admission, effects, kind, line);
+        }
+        // 违约之后的操作不会被提交 / Операции после дефолта не фиксируются
+        return result.kind != OpResult::Kind::Defaulted;
+    });
+}
+
+BankSystem::OpResult BankSystem::executeOperation(const ClientRow& clientRow,
+                                                  const Admission& admission,
+                                                  AppealEffects& effects,
+                                                  domain::Operation kind,
+                                                  std::string_view line) const {
+    // 未实现的操作统一返回“Service not available”。
+    auto fields = operationArguments(kind, line);
+    switch (kind) {
+        case domain::Operation::BalanceInquiry: {
+            unsigned long long accountId{};
+            if (!fields.separator() || !fields.readUnsigned(accountId)) {
+                return {OpResult::Kind::Message, "Client error. Unknown account"};
+            }
+            if (!isOperationAllowed(admission.kind, kind)) return {OpResult::Kind::Message, kServiceNotAvailable};
+            return evaluateBalanceInquiry(admission.clientId, accountId, effects);
+        }
+        case domain::Operation::CreateAccount: {
+            std::string_view currency;
+            if (!fields.separator() || !fields.readText(currency)) {
+                return {OpResult::Kind::Message, "Client error. Unknown currency"};
+            }
+            if (!isOperationAllowed(admission.kind, kind)) return {OpResult::Kind::Message, kServiceNotAvailable};
+            return evaluateCreateAccount(clientRow, admission.kind, domain::parseCurrency(currency), effects);
+        }
+        case domain::Operation::CloseAccount: {
+            unsigned long long accountId{};
+            if (!fields.separator() || !fields.readUnsigned(accountId)) {
+                return {OpResult::Kind::Message, "Client error. Unknown account"};
+            }
+            if (!isOperationAllowed(admission.kind, kind)) return {OpResult::Kind::Message, kServiceNotAvailable};
+            return evaluateCloseAccount(clientRow, accountId, effects);
+        }
+        case domain::Operation::CurrencyExchange:
+            if (!isOperationAllowed(admission.kind, kind)) return {OpResult::Kind::Message, kServiceNotAvailable};
+            return evaluateCurrencyExchange(line);
+        case domain::Operation::WithdrawFunds:
+        case domain::Operation::TopUpFunds:
+            if (!isOperationAllowed(admission.kind, kind)) return {OpResult::Kind::Message, kServiceNotAvailable};
+            return evaluatePosting(clientRow, kind, line, effects);
+        default:
+            return {OpResult::Kind::Message, kServiceNotAvailable};
+    }
+}
+
+BankSystem::OpResult BankSystem::evaluateBalanceInquiry(unsigned long long clientId,
+                                                        unsigned long long accountId,
+                                                        AppealEffects& effects) const {
+    // 一次下标访问同时得到余额与所有者。
+    const auto* row = accounts_.find(accountId);
+    // 今天新开的账户（尚未入表）与银行内部账户（手续费尚未入账）留到提交时再查。
+    // Открытые сегодня счета (ещё не в таблице) и внутренние счета банка (комиссии ещё не
+    // зачислены) проверяются при фиксации.
+    if (!row || isBankInternalAccount(*row)) {
+        return {OpResult::Kind::PendingBalance, nullptr, accountId};
+    }
+    // 权限校验：题目要求只能查询属于自己的账户。
+    if (!row->hasOwner || row->owner != clientId) {
+        return {OpResult::Kind::Message, "Client error. Access denied"};
+    }
+    const auto& effect = effects.touch(accountId);
+    if (!row->account.active || effect.closed) {
+        return {OpResult::Kind::Message, "Account closed"};
+    }
+    // 包含本来访之前已批准、尚未过账的变动 / С учётом одобренных, но ещё не проведённых изменений обращения
+    return {OpResult::Kind::Balance, nullptr, accountId, row->account.balance + effect.delta};
+}
+
+BankSystem::OpResult BankSystem::evaluateCreateAccount(const ClientRow& clientRow,
+                                                       domain::CustomerKind kind,
+                                                       domain::Currency currency,
+                                                       AppealEffects& effects) const {
+    // 1. 校验币种 + 账户数量限制
+    const auto currencyIdx = domain::currencyIndex(currency);
     if (currencyIdx < 0) {
-        std::printf("%llu # %llu:%llu # Client error. Unknown currency\n", day, hour, minute);
+        return {OpResult::Kind::Message, "Client error. Unknown currency"};
+    }
+    const auto c = static_cast<std::size_t>(currencyIdx);
+    effects.readsClient = true;
+    const auto allowedAccounts = accountLimit(kind, currency);
+    if (allowedAccounts > 0 && clientRow.activeAccounts[c].size() + effects.opened[c] - effects.closed[c] >= allowedAccounts) {
+        return {OpResult::Kind::Message, "Client error. Active account limit reached"};
+    }
+    ++effects.opened[c];
+
+    // 2. 银行内部账户收取手续费：没有该币种的内部账户需要触发“Bank defaulted”
+    if (!bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)]) {
+        return {OpResult::Kind::Defaulted};
+    }
+
+    // 3. 计算开户手续费，提交时过账；开户当天账户余额为负（题目说明）
+    OpResult result{OpResult::Kind::Created};
+    result.amount = accountOpeningFee(kind, currency);
+    result.currency = currency;
+    return result;
+}
+
+BankSystem::OpResult BankSystem::evaluateCloseAccount(const ClientRow& clientRow,
+                                                      unsigned long long accountId,
+                                                      AppealEffects& effects) const {
+    const auto* row = accounts_.find(accountId);
+    // 今天新开的账户要到提交阶段才有账号；之后的限额检查依赖提交结果
+    // Открытый сегодня счёт получает номер только при фиксации; от неё зависят следующие проверки лимита
+    if (!row) {
+        effects.ordered = true;
+        return {OpResult::Kind::PendingClose, nullptr, accountId};
+    }
+    const bool own = row->hasOwner && row->owner == clientRow.client.id;
+    auto* effect = own ? &effects.touch(accountId) : nullptr;
+    if (effect && effect->closed) return {OpResult::Kind::Message, "Account closed"};
+    auto result = prepareClose(*row, clientRow.client.id, row->account.balance + (effect ? effect->delta : domain::Money{}));
+    if (result.kind != OpResult::Kind::Closed) return result;
+    effect->closed = true;
+    ++effects.closed[static_cast<std::size_t>(domain::currencyIndex(result.currency))];
+    return result;
+}
+
+BankSystem::OpResult BankSystem::prepareClose(const AccountRow& row,
+                                              unsigned long long clientId,
+                                              domain::Money balance) const {
+    if (!row.hasOwner || row.owner != clientId) {
+        return {OpResult::Kind::Message, "Client error. Access denied"};
+    }
+    if (!row.account.active) {
+        return {OpResult::Kind::Message, "Account closed"};
+    }
+    // 存款与贷款账户随产品自动关闭，客户不能手动关闭；银行内部账户也不能关闭
+    // Счета депозитов и кредитов закрываются вместе с продуктом; внутренние счета банка не закрываются
+    if (row.product != Product::None || isBankInternalAccount(row)) {
+        return {OpResult::Kind::Message, "Client error. Access denied"};
+    }
+    if (balance < domain::Money{}) {
+        return {OpResult::Kind::Message, "Client error. Negative balance on closure"};
+    }
+    const auto currencyIdx = domain::currencyIndex(row.account.currency);
+    if (currencyIdx < 0 || !bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)]) {
+        return {OpResult::Kind::Defaulted};
+    }
+    // 手续费：余额的 1.5%，不少于 10 个货币单位，但不超过余额
+    // Комиссия: 1.5% остатка, не меньше 10 единиц, но не больше самого остатка
+    auto fee = std::max(balance.scaled(0.015), domain::Money::fromUnits(10));
+    fee = std::min(fee, balance);
+    OpResult result{OpResult::Kind::Closed, nullptr, row.account.id, balance - fee};
+    result.fee = fee;
+    result.currency = row.account.currency;
+    return result;
+}
+
+void BankSystem::indexAccount(ClientRow& clientRow, AccountRow& row) {
+    const auto currencyIdx = domain::currencyIndex(row.account.currency);
+    if (currencyIdx < 0) return;
+    auto& list = clientRow.activeAccounts[static_cast<std::size_t>(currencyIdx)];
+    row.slot = static_cast<std::uint32_t>(list.size());
+    list.push_back(row.account.id);
+}
+
+void BankSystem::closeAccount(AccountRow& row) {
+    row.account.active = false;
+    row.window = window_;
+    const auto currencyIdx = domain::currencyIndex(row.account.currency);
+    auto* clientRow = row.hasOwner ? clients_.find(row.owner) : nullptr;
+    if (!clientRow || currencyIdx < 0) return;
+    clientRow->window = window_;
+    // 与末尾交换后删除 / Удаление обменом с последним элементом
+    auto& list = clientRow->activeAccounts[static_cast<std::size_t>(currencyIdx)];
+    if (row.slot >= list.size() || list[row.slot] != row.account.id) return;
+    const auto last = list.back();
+    list[row.slot] = last;
+    if (auto* moved = accounts_.find(last)) moved->slot = row.slot;
+    list.pop_back();
+}
+
+BankSystem::OpResult BankSystem::evaluatePosting(const ClientRow& clientRow,
+                                                 domain::Operation operation,
+                                                 std::string_view line,
+                                                 AppealEffects& effects) const {
+    auto fields = operationArguments(operation, line);
+    unsigned long long accountId{};
+    domain::Money amount;
+    if (!fields.separator() || !fields.readUnsigned(accountId) || !fields.separator() || !readAmount(fields, amount)) {
+        return {OpResult::Kind::Message, "Client error. Unknown account"};
+    }
+    const auto* row = accounts_.find(accountId);
+    if (!row) {
+        OpResult pending{OpResult::Kind::PendingPosting, nullptr, accountId, amount};
+        pending.operation = operation;
+        return pending;
+    }
+    // 他人账户只看所有者（不会改变），不进入读集 / У чужого счёта смотрится только владелец (неизменный), в множество чтения не входит
+    const bool own = row->hasOwner && row->owner == clientRow.client.id;
+    auto* effect = own ? &effects.touch(accountId) : nullptr;
+    if (effect && effect->closed) return {OpResult::Kind::Message, "Account closed"};
+    auto result = preparePosting(*row, clientRow.client.id, operation, amount,
+                                 row->account.balance + (effect ? effect->delta : domain::Money{}));
+    if (result.kind != OpResult::Kind::Posted) return result;
+    effect->delta += operation == domain::Operation::WithdrawFunds ? -(result.amount + result.fee) : result.amount - result.fee;
+    return result;
+}
+
+BankSystem::OpResult BankSystem::preparePosting(const AccountRow& row,
+                                                unsigned long long clientId,
+                                                domain::Operation operation,
+                                                domain::Money amount,
+                                                domain::Money projected) const {
+    if (!row.hasOwner || row.owner != clientId) {
+        return {OpResult::Kind::Message, "Client error. Access denied"};
+    }
+    if (!row.account.active) {
+        return {OpResult::Kind::Message, "Account closed"};
+    }
+    const bool withdraw = operation == domain::Operation::WithdrawFunds;
+    // 存款只能在期满后取款且不能充值；贷款账户只能充值（还款）
+    // С депозита можно только снимать после окончания срока; кредитный счёт можно только пополнять (погашение)
+    const bool matured = row.product == Product::Deposit && currentTime_.day >= row.maturesOn;
+    if (isBankInternalAccount(row) ||
+        (withdraw ? row.product == Product::Loan || (row.product == Product::Deposit && !matured)
+                  : row.product == Product::Deposit)) {
+        return {OpResult::Kind::Message, "Client error. Access denied"};
+    }
+    const auto currencyIdx = domain::currencyIndex(row.account.currency);
+    if (currencyIdx < 0 || !bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)]) {
+        return {OpResult::Kind::Defaulted};
+    }
+    // 取款：0.25%，不少于 2.5（到期存款免收）；充值：0.01%，不少于 1。手续费从账户扣除
+    // Снятие: 0.25%, не меньше 2.5 (с истёкшего депозита - 0); пополнение: 0.01%, не меньше 1. Комиссия списывается со счёта
+    domain::Money fee;
+    if (withdraw) {
+        fee = matured ? domain::Money{} : std::max(amount.scaled(0.0025), domain::Money::fromThousandths(2500));
+    } else {
+        fee = std::max(amount.scaled(0.0001), domain::Money::fromUnits(1));
+    }
+    // 取款后余额（含手续费）不能为负；充值金额至少要覆盖手续费
+    // Остаток после снятия (с комиссией) не может быть отрицательным; пополнение должно покрывать комиссию
+    const auto after = withdraw ? projected - amount - fee : projected + amount - fee;
+    if (withdraw ? after < domain::Money{} : amount < fee) {
+        return {OpResult::Kind::Message, "Client error. Insufficient funds"};
+    }
+    if (!withdraw && row.product == Product::Loan && after > row.loanAmount) {
+        return {OpResult::Kind::Message, "Client error. Invalid loan payment amount"};
+    }
+    OpResult result{OpResult::Kind::Posted, nullptr, row.account.id, amount};
+    result.fee = fee;
+    result.operation = operation;
+    result.currency = row.account.currency;
+    return result;
+}
+
+BankSystem::OpResult BankSystem::evaluateCurrencyExchange(std::string_view line) const {
+    // "Currency Exchange # %99[a-zA-Z0-9/_ ] -> %99[a-zA-Z0-9/_ ] # %llu.%llu"
+    auto fields = operationArguments(domain::Operation::CurrencyExchange, line);
+    std::string_view sold;
+    std::string_view bought;
+    unsigned long long major{};
+    unsigned long long minor{};
+    bool parsed = fields.separator() && fields.readText(sold) && fields.literal('-') && fields.literal('>');
+    fields.skipSpaces();
+    parsed = parsed && fields.readText(bought) && fields.separator() && fields.readMoney(major, minor);
+    if (!parsed) {
+        return {OpResult::Kind::Message, "Can't perform exchange"};
+    }
+    const auto from = domain::currencyIndex(domain::parseCurrency(sold));
+    const auto to = domain::currencyIndex(domain::parseCurrency(bought));
+    if (from < 0 || to < 0) {
+        return {OpResult::Kind::Message, "Client error. Unknown currency"};
+    }
+    // 汇率矩阵 O(1) 取值；0 表示没有报价也无法经交叉汇率得到
+    // Курс из матрицы за O(1); 0 - нет ни котировки, ни кросс-курса
+    const double rate = rates_[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)];
+    if (from == to || rate == 0.0 ||
+        !bankInternalAccounts_[static_cast<std::size_t>(from)] || !bankInternalAccounts_[static_cast<std::size_t>(to)]) {
+        return {OpResult::Kind::Message, "Can't perform exchange"};
+    }
+    OpResult result{OpResult::Kind::Exchanged};
+    result.soldAmount = domain::parseMoneyParts(major, minor);
+    result.soldCurrency = static_cast<domain::Currency>(from);
+    result.amount = domain::Money::fromDouble(result.soldAmount.toDouble() * rate);
+    result.currency = static_cast<domain::Currency>(to);
+    return result;
+}
+
+void BankSystem::commitAppeal(const AppealRequest& request,
+                              const Admission& admission,
+                              const std::pmr::vector<OpResult>& results) {
+    if (!admission.admitted) {
+        for (const auto& result : results) commitOperation(request, admission, result);
         return;
     }
-    auto& perCurrency = accountCountByCurrency_[client.id];
-    auto currentCount = perCurrency[currencyIdx];
-    if (allowedAccounts > 0 && currentCount >= allowedAccounts) {
-        std::printf("%llu # %llu:%llu # Client error. Active account limit reached\n", day, hour, minute);
+    scheduleAppeal(request, admission);
+    // results 与操作一一对应（违约时提前结束）/ results соответствуют операциям (при дефолте короче)
+    std::size_t index = 0;
+    forEachOperation(request.operations, request.operationCount, [&](domain::Operation kind, std::string_view) {
+        if (index == results.size()) return false;
+        const auto& result = results[index++];
+        BANK_PROFILE_SCOPE(profiler_, kind, result.nanos);
+        scheduleOperation(admission, kind, result);
+        return commitOperation(request, admission, result);
+    });
+}
+
+bool BankSystem::commitOperation(const AppealRequest& request, const Admission& admission, const OpResult& result) {
+    const auto day = request.day;
+    const auto hour = request.hour;
+    const auto minute = request.minute;
+    switch (result.kind) {
+        case OpResult::Kind::LogError:
+            logError(result.message);
+            break;
+        case OpResult::Kind::Message:
+            respond(day, hour, minute, result.message);
+            break;
+        case OpResult::Kind::Balance:
+            stamp(out_, day, hour, minute).text("Balance of ").number(result.accountId).text(" # ").money(result.amount).put('\n');
+            break;
+        case OpResult::Kind::PendingBalance: {
+            const auto* row = accounts_.find(result.accountId);
+            if (!row) {
+                respond(day, hour, minute, "Client error. Unknown account");
+                break;
+            }
+            if (!row->hasOwner || row->owner != admission.clientId) {
+                respond(day, hour, minute, "Client error. Access denied");
+                break;
+            }
+            if (!row->account.active) {
+                respond(day, hour, minute, "Account closed");
+                break;
+            }
+            stamp(out_, day, hour, minute).text("Balance of ").number(result.accountId).text(" # ").money(row->account.balance).put('\n');
+            break;
+        }
+        case OpResult::Kind::Created: {
+            // 账号按提交顺序分配，与顺序执行完全一致 / Номера выдаются в порядке фиксации, как при последовательном выполнении
+            const auto currencyIdx = static_cast<std::size_t>(domain::currencyIndex(result.currency));
+            const unsigned long long accountId = nextAccountId_++;
+            insertAccount(accountId, admission.clientId, result.currency, domain::AccountKind::Deposit, domain::Money{});
+            if (history_) history_->record(accountId, {day, hour, minute}, domain::Money{});
+            if (alerts_) reportAlerts(rules_.onAccountOpened({day, hour, minute}, admission.clientId, accountId), day, hour, minute);
+            if (journal_.active()) {
+                journal_.openAccount(accountId, admission.clientId, result.currency, domain::AccountKind::Deposit, domain::Money{});
+            }
+            // 手续费不做余额校验：开户当天余额为负 / Комиссия без проверки остатка: в день открытия остаток отрицательный
+            ledger_.add(accountId, *bankInternalAccounts_[currencyIdx], result.amount, false);
+            applyPostings(checkPostings(), day, hour, minute);
+            dayStats_.fees[currencyIdx] += result.amount;
+            stamp(out_, day, hour, minute).text("Account Created ").number(accountId).text(" # ").money(-result.amount).put('\n');
+            break;
+        }
+        case OpResult::Kind::Exchanged: {
+            // 兑换 0% 手续费：现金存入出售货币的内部账户，再从购买货币的内部账户付出
+            // Обмен без комиссии: наличные на внутренний счёт продаваемой валюты, выдача с внутреннего счёта покупаемой
+            const auto soldIdx = static_cast<std::size_t>(domain::currencyIndex(result.soldCurrency));
+            const auto boughtIdx = static_cast<std::size_t>(domain::currencyIndex(result.currency));
+            ledger_.add(Ledger::kCash, *bankInternalAccounts_[soldIdx], result.soldAmount);
+            ledger_.add(*bankInternalAccounts_[boughtIdx], Ledger::kCash, result.amount);
+            if (checkPostings() != ledger_.batch().size()) {
+                ledger_.clear();
+                respond(day, hour, minute, "Can't perform exchange");
+                break;
+            }
+            applyPostings(ledger_.batch().size(), day, hour, minute);
+            stamp(out_, day, hour, minute).text("Currency Exchange Performed # ").money(result.amount).text(" \n");
+            break;
+        }
+        case OpResult::Kind::PendingClose: {
+            auto* row = accounts_.find(result.accountId);
+            if (!row) {
+                respond(day, hour, minute, "Client error. Unknown account");
+                break;
+            }
+            const auto closed = prepareClose(*row, admission.clientId, row->account.balance);
+            if (closed.kind == OpResult::Kind::Defaulted) {
+                defaultBank(day, hour, minute);
+                return false;
+            }
+            if (closed.kind != OpResult::Kind::Closed) {
+                respond(day, hour, minute, closed.message);
+                break;
+            }
+            closeAccount(*row);
+            commitClose(day, hour, minute, *row, closed);
+            break;
+        }
+        case OpResult::Kind::Closed: {
+            auto& row = *accounts_.find(result.accountId);
+            closeAccount(row);
+            commitClose(day, hour, minute, row, result);
+            break;
+        }
+        case OpResult::Kind::PendingPosting: {
+            auto* row = accounts_.find(result.accountId);
+            if (!row) {
+                respond(day, hour, minute, "Client error. Unknown account");
+                break;
+            }
+            const auto posted = preparePosting(*row, admission.clientId, result.operation, result.amount, row->account.balance);
+            if (posted.kind == OpResult::Kind::Defaulted) {
+                defaultBank(day, hour, minute);
+                return false;
+            }
+            if (posted.kind != OpResult::Kind::Posted) {
+                respond(day, hour, minute, posted.message);
+                break;
+            }
+            commitPosting(day, hour, minute, *row, posted);
+            break;
+        }
+        case OpResult::Kind::Posted: {
+            commitPosting(day, hour, minute, *accounts_.find(result.accountId), result);
+            break;
+        }
+        case OpResult::Kind::Defaulted:
+            defaultBank(day, hour, minute);
+            return false;
+    }
+    return true;
+}
+
+void BankSystem::commitClose(unsigned long long day,
+                             unsigned long long hour,
+                             unsigned long long minute,
+                             AccountRow& row,
+                             const OpResult& result) {
+    // 余额全部转出：手续费进内部账户，其余以现金付给客户
+    // Остаток списывается полностью: комиссия на внутренний счёт, остальное - наличными клиенту
+    const auto currencyIdx = static_cast<std::size_t>(domain::currencyIndex(result.currency));
+    ledger_.add(row.account.id, *bankInternalAccounts_[currencyIdx], result.fee);
+    ledger_.add(row.account.id, Ledger::kCash, result.amount);
+    applyPostings(checkPostings(), day, hour, minute);
+    dayStats_.fees[currencyIdx] += result.fee;
+    if (journal_.active()) journal_.closeAccount(row.account.id);
+    stamp(out_, day, hour, minute).text("Account closed ").number(row.account.id).text(" # ").money(result.amount).put('\n');
+}
+
+void BankSystem::commitPosting(unsigned long long day,
+                               unsigned long long hour,
+                               unsigned long long minute,
+                               AccountRow& row,
+                               const OpResult& result) {
+    const auto currencyIdx = static_cast<std::size_t>(domain::currencyIndex(result.currency));
+    const auto internalId = *bankInternalAccounts_[currencyIdx];
+    const bool withdraw = result.operation == domain::Operation::WithdrawFunds;
+    if (withdraw) {
+        ledger_.add(row.account.id, Ledger::kCash, result.amount);
+        ledger_.add(row.account.id, internalId, result.fee);
+    } else {
+        ledger_.add(Ledger::kCash, row.account.id, result.amount);
+        ledger_.add(row.account.id, internalId, result.fee, false);
+    }
+    // 执行阶段已按预计余额校验，这里的校验只防止批次部分过账
+    // Проверено на этапе выполнения по ожидаемому остатку; здесь проверка лишь исключает частичную проводку
+    if (checkPostings() != ledger_.batch().size()) {
+        ledger_.clear();
+        respond(day, hour, minute, "Client error. Insufficient funds");
         return;
     }
+    applyPostings(ledger_.batch().size(), day, hour, minute);
+    dayStats_.fees[currencyIdx] += result.fee;
+    stamp(out_, day, hour, minute).text(withdraw ? "Funds Withdrawn " : "Fonds Credited ").number(row.account.id)
+        .text(" # ").money(row.account.balance).put('\n');
+}
 
-    // 2. 计算开户手续费，开户当天账户余额为负（题目说明）
-    double fee = accountOpeningFee(kind, currency);
-    double balance = -fee;
+std::size_t BankSystem::checkPostings() {
+    const auto& batch = ledger_.batch();
+    postingRows_.resize(batch.size());
+    // 新的批次标记使所有行的滚动余额失效 / Новая метка пакета делает текущие остатки всех строк недействительными
+    ++postingEpoch_;
+    const auto running = [this](AccountRow& row) -> domain::Money& {
+        if (row.postingMark != postingEpoch_) {
+            row.postingMark = postingEpoch_;
+            row.postingBalance = row.account.balance;
+        }
+        return row.postingBalance;
+    };
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& posting = batch[i];
+        auto* from = posting.from == Ledger::kCash ? nullptr : accounts_.find(posting.from);
+        auto* to = posting.to == Ledger::kCash ? nullptr : accounts_.find(posting.to);
+        if ((posting.from != Ledger::kCash && !from) || (posting.to != Ledger::kCash && !to)) return i;
+        if (from) {
+            auto& balance = running(*from);
+            if (posting.checked && balance < posting.amount) return i;
+            balance -= posting.amount;
+        }
+        if (to) running(*to) += posting.amount;
+        postingRows_[i] = {from, to};
+    }
+    return batch.size();
+}
 
-    unsigned long long accountId = nextAccountId_++;
-    domain::Account newAccount{};
-    newAccount.id = accountId;
-    newAccount.type = "deposit";
-    newAccount.balance = balance;
-    newAccount.currency = currencyStr;
-    newAccount.active = true;
-    accounts_.emplace(accountId, newAccount);
+void BankSystem::applyPostings(std::size_t count, unsigned long long day, unsigned long long hour, unsigned long long minute) {
+    const auto& batch = ledger_.batch();
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& posting = batch[i];
+        auto* from = postingRows_[i][0];
+        auto* to = postingRows_[i][1];
+        if (from) changeBalance(*from, -posting.amount);
+        if (to) changeBalance(*to, posting.amount);
+        if (history_) {
+            if (from) history_->record(posting.from, {day, hour, minute}, from->account.balance);
+            if (to) history_->record(posting.to, {day, hour, minute}, to->account.balance);
+        }
+        if (alerts_) {
+            // 发起方：借方账户的所有者，现金存入时为贷方账户的所有者
+            // Инициатор: владелец счёта дебета, при внесении наличных - владелец счёта кредита
+            const auto* party = from ? from : to;
+            if (party && party->hasOwner && (party == from || posting.from == Ledger::kCash)) {
+                reportAlerts(rules_.onPosting({day, hour, minute}, party->owner, party->account.id, party->account.currency,
+                                              posting.amount),
+                             day, hour, minute);
+            }
+        }
+        // 交易日志仍按题目格式逐行输出 / Журнал транзакций по-прежнему построчно в формате задачи
+        if (!from) {
+            logAccountDeposit(day, hour, minute, posting.to, posting.amount);
+        } else if (!to) {
+            logAccountWithdrawal(day, hour, minute, posting.from, posting.amount);
+        } else {
+            logAccountTransfer(day, hour, minute, posting.from, posting.to, posting.amount);
+        }
+    }
+    ledger_.record(count, day, hour, minute);
+}
+
+void BankSystem::accrueInterest(unsigned long long day, AccrualPeriod period) {
+    const auto hour = currentTime_.hour;
+    const auto minute = currentTime_.minute;
+    interest_.retireMatured(day);
+
+    // 1. 贷款：从贷款账户转入银行内部账户 / Кредиты: с кредитного счёта на внутренний счёт банка
+    auto& loans = interest_.loans(period);
+    for (std::size_t i = 0; i < loans.size(); ++i) {
+        const auto* row = accounts_.find(loans.account[i]);
+        // 已关闭的账户按本金计息为零 / Закрытый счёт даёт нулевую базу
+        loans.base[i] = row && row->account.active ? row->account.balance.thousandths : loans.principal[i];
+    }
+    InterestEngine::computeLoans(loans);
+    for (std::size_t i = 0; i < loans.size(); ++i) {
+        if (loans.interest[i] == 0) continue;
+        const auto* row = accounts_.find(loans.account[i]);
+        const auto currencyIdx = domain::currencyIndex(row->account.currency);
+        if (currencyIdx < 0 || !bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)]) continue;
+        const auto bankId = *bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)];
+        if (!accounts_.contains(bankId)) continue;
+        ledger_.add(row->account.id, bankId, domain::Money::fromThousandths(loans.interest[i]));
+    }
+    // 余额不足的第一笔之前的分录照常过账 / Проводки до первой невыполнимой проводятся как обычно
+    const auto loanPostings = ledger_.batch().size();
+    const auto loansPosted = checkPostings();
+    applyPostings(loansPosted, day, hour, minute);
+    if (loansPosted != loanPostings) {
+        defaultClient(day, hour, minute);
+        return;
+    }
+
+    // 2. 存款：从银行内部账户转入存款账户 / Депозиты: с внутреннего счёта банка на депозитный счёт
+    auto& deposits = interest_.deposits(period);
+    for (std::size_t i = 0; i < deposits.size(); ++i) {
+        const auto* row = accounts_.find(deposits.account[i]);
+        if (!row || !row->account.active) {
+            deposits.base[i] = 0;
+        } else {
+            deposits.base[i] = (deposits.minimum[i] ? dayMinimum(*row, day) : row->account.balance).thousandths;
+        }
+    }
+    InterestEngine::computeDeposits(deposits, day);
+    bool missingBank = false;
+    for (std::size_t i = 0; i < deposits.size() && !missingBank; ++i) {
+        if (deposits.interest[i] == 0) continue;
+        const auto* row = accounts_.find(deposits.account[i]);
+        const auto currencyIdx = domain::currencyIndex(row->account.currency);
+        // 没有内部账户时银行违约，之前的分录仍然过账 / Без внутреннего счёта - дефолт банка, предыдущие проводки проводятся
+        missingBank = currencyIdx < 0 || !bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)] ||
+                      !accounts_.contains(*bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)]);
+        if (missingBank) break;
+        ledger_.add(*bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)], row->account.id,
+                    domain::Money::fromThousandths(deposits.interest[i]));
+    }
+    const auto depositPostings = ledger_.batch().size();
+    const auto depositsPosted = checkPostings();
+    applyPostings(depositsPosted, day, hour, minute);
+    if (missingBank || depositsPosted != depositPostings) defaultBank(day, hour, minute);
+}
+
+void BankSystem::changeBalance(AccountRow& row, domain::Money delta) {
+    if (row.minDay != currentTime_.day) {
+        row.minDay = currentTime_.day;
+        row.dayMin = row.account.balance;
+        row.dayIn = {};
+        row.dayOut = {};
+        row.dayPostings = 0;
+    }
+    row.account.balance += delta;
+    row.window = window_;
+    if (delta < domain::Money{}) {
+        row.dayOut -= delta;
+    } else {
+        row.dayIn += delta;
+    }
+    ++row.dayPostings;
+    if (row.account.balance < row.dayMin) row.dayMin = row.account.balance;
+    if (journal_.active()) journal_.balance(row.account.id, delta);
+}
+
+void BankSystem::insertAccount(unsigned long long accountId,
+                               unsigned long long clientId,
+                               domain::Currency currency,
+                               domain::AccountKind kind,
+                               domain::Money balance) {
+    AccountRow newRow{};
+    newRow.account.id = accountId;
+    newRow.account.type = kind;
+    newRow.account.balance = balance;
+    newRow.account.currency = currency;
+    newRow.account.active = true;
+    newRow.owner = clientId;
+    newRow.hasOwner = true;
+    auto* row = accounts_.emplace(accountId, std::move(newRow)).first;
+    if (auto* clientRow = clients_.find(clientId)) {
+        indexAccount(*clientRow, *row);
+        clientRow->window = window_;
+    }
 
-    // 3. 建立客户-账户关系并更新各类辅助索引
     domain::ClientAccount rel{};
-    rel.clientId = client.id;
+    rel.clientId = clientId;
     rel.accountId = accountId;
-    clientAccounts_[client.id].push_back(rel);
-    accountOwners_[accountId] = client.id;
-    perCurrency[currencyIdx] = currentCount + 1;
+    clientAccounts_[clientId].push_back(rel);
+}
+
+domain::Money BankSystem::dayMinimum(const AccountRow& row, unsigned long long day) const {
+    return row.minDay == day ? row.dayMin : row.account.balance;
+}
 
-    // 4. 银行内部账户收取手续费：若余额不足需要触发“Bank defaulted”
-    auto bankAccountIt = bankInternalAccounts_.find(currencyStr);
-    if (bankAccountIt == bankInternalAccounts_.end()) {
-        std::printf("%llu # %llu:%llu # Bank defaulted\n", day, hour, minute);
-        std::exit(EXIT_FAILURE);
+void BankSystem::scheduleAppeal(const AppealRequest& request, const Admission& admission) {
+    scheduler_.addCustomer(static_cast<std::uint32_t>(request.hour * 60 + request.minute), domain::isVip(admission.kind));
+    if (admission.registered) {
+        scheduler_.addService(domain::WorkplaceKind::ClientManager, domain::kRegistrationMinutes);
     }
-    auto bankAccount = findAccount(bankAccountIt->second);
-    if (bankAccount) {
-        bankAccount->balance += fee;
+}
+
+void BankSystem::scheduleOperation(const Admission& admission, domain::Operation kind, const OpResult& result) {
+    if (result.kind == OpResult::Kind::Message && result.message == kServiceNotAvailable) return;
+    scheduler_.addService(domain::workplaceFor(kind, admission.kind), domain::serviceMinutes(kind));
+}
+
+bool BankSystem::isBankInternalAccount(const AccountRow& row) const {
+    const auto currencyIdx = domain::currencyIndex(row.account.currency);
+    if (currencyIdx < 0) return false;
+    const auto& internalId = bankInternalAccounts_[static_cast<std::size_t>(currencyIdx)];
+    return internalId && *internalId == row.account.id;
+}
+
+void BankSystem::setAppealShards(std::size_t shards) {
+    flushAppealBatch();
+    appealShards_ = shards;
+    if (shards > 1) {
+        appealPool_ = std::make_unique<ThreadPool>(shards);
+    } else {
+        appealPool_.reset();
+    }
+}
+
+void BankSystem::flushAppealBatch() {
+    if (appealBatch_.empty()) return;
+    const auto count = appealBatch_.size();
+    const auto window = speculationWindow_ == 0 ? count : speculationWindow_;
+    for (std::size_t begin = 0; begin < count && !halted_; begin += window) {
+        speculateWindow(begin, std::min(count, begin + window));
+    }
+    appealBatch_.clear();
+}
+
+void BankSystem::speculateWindow(std::size_t begin, std::size_t end) {
+    const auto count = end - begin;
+    const AppealRequest* requests = appealBatch_.data() + begin;
+    // 新窗口：此后提交修改的行都带上新的编号 / Новое окно: изменённые дальше строки получают новый номер
+    ++window_;
+
+    // 1. 顺序识别客户：新客户编号按事件顺序分配 / Последовательная идентификация клиентов в порядке событий
+    std::pmr::vector<Admission> admissions(count, &dayArena_);
+    for (std::size_t i = 0; i < count; ++i) admissions[i] = admitAppeal(requests[i]);
+
+    // 2. 并行推测执行：共享状态只读，线程依次领取下一个来访
+    //    Параллельное спекулятивное выполнение: общее состояние только читается, потоки берут следующее обращение
+    //    dayArena_ 不是线程安全的：容量在这里一次预留（每个操作至多一个结果、一个读入的账户）
+    //    dayArena_ не потокобезопасна: ёмкость резервируется здесь (не больше одного результата и счёта на операцию)
+    std::pmr::vector<std::pmr::vector<OpResult>> results(count, &dayArena_);
+    std::pmr::vector<AppealEffects> effects(count, &dayArena_);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto capacity = std::max<std::size_t>(1, requests[i].operationCount);
+        results[i].reserve(capacity);
+        effects[i].accounts.reserve(capacity);
+    }
+    std::atomic<std::size_t> next{0};
+    for (std::size_t t = 0; t < appealShards_; ++t) {
+        appealPool_->submit([this, count, requests, &next, &admissions, &effects, &results] {
+            for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                executeAppeal(requests[i], admissions[i], effects[i], results[i]);
+            }
+        });
     }
+    appealPool_->wait();
 
-    logAccountTransfer(day, hour, minute, accountId, bankAccountIt->second, fee);
+    // 3. 按原始顺序验证并提交：分配账号、经账簿过账、输出
+    //    Проверка и фиксация в исходном порядке: номера счетов, проводки через книгу, вывод
+    for (std::size_t i = 0; i < count && !halted_; ++i) {
+        if (effects[i].ordered || speculationStale(admissions[i], effects[i])) {
+            ++speculationStats_.reexecuted;
+            processAppeal(requests[i], admissions[i]);
+        } else {
+            commitAppeal(requests[i], admissions[i], results[i]);
+        }
+    }
+    speculationStats_.appeals += count;
+}
 
-    // 5. 正常输出题目要求的响应格式
-    auto fmt = domain::formatMoney(newAccount.balance);
-    std::printf("%llu # %llu:%llu # Account Created %llu # %s%llu.%03llu\n",
-                day,
-                hour,
-                minute,
-                accountId,
-                fmt.negative ? "-" : "",
-                fmt.major,
-                fmt.minor);
+bool BankSystem::speculationStale(const Admission& admission, const AppealEffects& effects) const {
+    if (!admission.admitted) return false;
+    if (effects.readsClient && clients_.find(admission.clientId)->window == window_) return true;
+    return std::any_of(effects.accounts.begin(), effects.accounts.end(), [this](const AppealEffects::AccountEffect& effect) {
+        return accounts_.find(effect.accountId)->window == window_;
+    });
+}
+
+namespace {
+constexpr std::uint64_t kSnapshotMagic = 0x31504e534b4e4142ULL;   // "BANKSNP1"
+constexpr const char* kSnapshotFile = "snapshot.bin";
+constexpr const char* kJournalFile = "journal.bin";
+
+std::string journalPath(const std::string& directory, const char* file) {
+    return (std::filesystem::path(directory) / file).string();
+}
+}  // namespace
+
+bool BankSystem::enableLedger(const std::string& path) {
+    if (!ledger_.open(path)) {
+        std::fprintf(stderr, "Failed to open ledger %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BankSystem::enableRules(const std::string& rulesPath, std::FILE* alerts) {
+    if (!rules_.load(rulesPath)) return false;
+    alerts_ = std::make_unique<io::OutputSink>(alerts);
+    return true;
+}
+
+void BankSystem::enableProfileReport(std::FILE* report) {
+    profile_ = std::make_unique<io::OutputSink>(report);
+}
+
+bool BankSystem::enableColumnarExport(const std::string& path) {
+    if (!columnar_.open(path)) {
+        std::fprintf(stderr, "Failed to open columnar export %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BankSystem::enableJournal(const std::string& directory, unsigned long long snapshotEveryDays) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::fprintf(stderr, "Failed to create journal directory %s\n", directory.c_str());
+        return false;
+    }
+    journalDir_ = directory;
+    snapshotEveryDays_ = std::max<unsigned long long>(1, snapshotEveryDays);
+    daysSinceSnapshot_ = 0;
+
+    // 1. 最近的快照 / Последний снимок
+    unsigned long long day = 0;
+    std::size_t resumeOffset = 0;
+    bool resumed = false;
+    std::string data;
+    if (readWholeFile(journalPath(directory, kSnapshotFile), data)) {
+        if (!restoreSnapshot(data, day, resumeOffset)) {
+            std::fprintf(stderr, "Corrupted snapshot in %s\n", directory.c_str());
+            return false;
+        }
+        resumed = true;
+    }
+
+    // 2. 已提交的日志尾部；快照写成但日志尚未清空时，跳过快照已包含的营业日
+    //    Зафиксированный хвост журнала; если снимок записан, а журнал ещё не очищен,
+    //    дни, уже вошедшие в снимок, пропускаются
+    std::vector<JournalRecord> records;
+    std::size_t validBytes = 0;
+    if (!readJournal(journalPath(directory, kJournalFile), records, validBytes)) {
+        std::fprintf(stderr, "Failed to read journal in %s\n", directory.c_str());
+        return false;
+    }
+    std::size_t segmentStart = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].type != JournalRecordType::EndOfDay) continue;
+        if (records[i].other > resumeOffset) {
+            for (std::size_t j = segmentStart; j < i; ++j) replayRecord(records[j]);
+            day = records[i].id;
+            resumeOffset = static_cast<std::size_t>(records[i].other);
+            resumed = true;
+        }
+        segmentStart = i + 1;
+    }
+
+    // 3. 事件流从最后提交的营业日之后继续 / Поток событий продолжается после последнего зафиксированного дня
+    if (resumed) {
+        if (resumeOffset < cursor_.offset() || resumeOffset > input_.view().size()) {
+            std::fprintf(stderr, "Journal in %s does not match the input\n", directory.c_str());
+            return false;
+        }
+        cursor_.seek(resumeOffset);
+        currentTime_ = {day, 19, 0};
+        bankDayStarted_ = true;
+        bankDayClosed_ = true;
+    }
+    if (!journal_.open(journalPath(directory, kJournalFile), validBytes)) {
+        std::fprintf(stderr, "Failed to open journal in %s\n", directory.c_str());
+        return false;
+    }
+    return true;
+}
+
+void BankSystem::commitJournalDay(unsigned long long day) {
+    const auto offset = cursor_.offset();
+    if (!journal_.commitDay(day, offset)) {
+        logError("Failed to write journal");
+        return;
+    }
+    if (++daysSinceSnapshot_ < snapshotEveryDays_) return;
+    // 快照写成后再清空日志；两步之间崩溃时，重启会跳过重复的营业日
+    // Журнал очищается после записи снимка; при сбое между шагами повторные дни пропускаются при перезапуске
+    if (!writeFileAtomically(journalPath(journalDir_, kSnapshotFile), encodeSnapshot(day, offset)) || !journal_.truncate()) {
+        logError("Failed to write snapshot");
+        return;
+    }
+    daysSinceSnapshot_ = 0;
+}
+
+std::string BankSystem::encodeSnapshot(unsigned long long day, std::size_t inputOffset) const {
+    BinaryWriter writer;
+    writer.put(kSnapshotMagic);
+    writer.put(day);
+    writer.put(static_cast<unsigned long long>(inputOffset));
+    writer.put(nextAccountId_);
+    writer.put(nextClientId_);
+
+    writer.put(static_cast<unsigned long long>(accounts_.size()));
+    accounts_.forEach([&writer](unsigned long long id, const AccountRow& row) {
+        writer.put(id);
+        writer.put(static_cast<std::uint8_t>(row.account.type));
+        writer.put(static_cast<std::uint8_t>(row.account.currency));
+        writer.put(static_cast<std::uint8_t>(row.account.active));
+        writer.put(static_cast<std::uint8_t>(row.hasOwner));
+        writer.put(row.owner);
+        writer.put(row.account.balance.thousandths);
+    });
+
+    writer.put(static_cast<unsigned long long>(clients_.size()));
+    clients_.forEach([&writer](unsigned long long id, const ClientRow& row) {
+        writer.put(id);
+        writer.put(static_cast<std::uint8_t>(row.client.type));
+        writer.putText(row.client.name);
+    });
+
+    unsigned long long relations = 0;
+    for (const auto& entry : clientAccounts_) relations += entry.second.size();
+    writer.put(relations);
+    for (const auto& [clientId, list] : clientAccounts_) {
+        for (const auto& rel : list) {
+            writer.put(clientId);
+            writer.put(rel.accountId);
+            writer.put(rel.depositId);
+            writer.put(rel.loanId);
+            writer.put(static_cast<std::uint8_t>((rel.isLoanAccount ? 1 : 0) | (rel.isDepositAccount ? 2 : 0)));
+        }
+    }
+    return std::move(writer.data());
+}
+
+bool BankSystem::restoreSnapshot(const std::string& data, unsigned long long& day, std::size_t& inputOffset) {
+    BinaryReader reader(data);
+    std::uint64_t magic{};
+    unsigned long long offset{};
+    unsigned long long nextAccountId{};
+    unsigned long long nextClientId{};
+    if (!reader.get(magic) || magic != kSnapshotMagic || !reader.get(day) || !reader.get(offset) ||
+        !reader.get(nextAccountId) || !reader.get(nextClientId)) {
+        return false;
+    }
+
+    unsigned long long count{};
+    if (!reader.get(count)) return false;
+    DenseTable<AccountRow> accounts;
+    accounts.reserve(static_cast<std::size_t>(count));
+    for (unsigned long long i = 0; i < count; ++i) {
+        AccountRow row{};
+        std::uint8_t type{}, currency{}, active{}, hasOwner{};
+        if (!reader.get(row.account.id) || !reader.get(type) || !reader.get(currency) || !reader.get(active) ||
+            !reader.get(hasOwner) || !reader.get(row.owner) || !reader.get(row.account.balance.thousandths)) {
+            return false;
+        }
+        row.account.type = static_cast<domain::AccountKind>(type);
+        row.account.currency = static_cast<domain::Currency>(currency);
+        row.account.active = active != 0;
+        row.hasOwner = hasOwner != 0;
+        accounts.emplace(row.account.id, std::move(row));
+    }
+
+    if (!reader.get(count)) return false;
+    DenseTable<ClientRow> clients;
+    clients.reserve(static_cast<std::size_t>(count));
+    for (unsigned long long i = 0; i < count; ++i) {
+        ClientRow row(&nodePool_);
+        std::uint8_t type{};
+        if (!reader.get(row.client.id) || !reader.get(type) || !reader.getText(row.client.name)) return false;
+        row.client.type = static_cast<domain::CustomerKind>(type);
+        clients.emplace(row.client.id, std::move(row));
+    }
+
+    if (!reader.get(count)) return false;
+    ClientAccountMap relations(&nodePool_);
+    for (unsigned long long i = 0; i < count; ++i) {
+        domain::ClientAccount rel{};
+        std::uint8_t flags{};
+        if (!reader.get(rel.clientId) || !reader.get(rel.accountId) || !reader.get(rel.depositId) ||
+            !reader.get(rel.loanId) || !reader.get(flags)) {
+            return false;
+        }
+        rel.isLoanAccount = (flags & 1) != 0;
+        rel.isDepositAccount = (flags & 2) != 0;
+        relations[rel.clientId].push_back(rel);
+    }
+
+    accounts_ = std::move(accounts);
+    clients_ = std::move(clients);
+    clientAccounts_ = std::move(relations);
+    clientNameToId_.clear();
+    buildDerivedState();
+    nextAccountId_ = nextAccountId;
+    nextClientId_ = nextClientId;
+    inputOffset = static_cast<std::size_t>(offset);
+    return true;
+}
+
+void BankSystem::replayRecord(const JournalRecord& record) {
+    switch (record.type) {
+        case JournalRecordType::Balance:
+            if (auto* row = accounts_.find(record.id)) row->account.balance += record.amount;
+            break;
+        case JournalRecordType::OpenAccount: {
+            const auto currency = static_cast<domain::Currency>(record.currency);
+            insertAccount(record.id, record.other, currency, static_cast<domain::AccountKind>(record.kind), record.amount);
+            nextAccountId_ = std::max(nextAccountId_, record.id + 1);
+            break;
+        }
+        case JournalRecordType::NewClient: {
+            ClientRow row(&nodePool_);
+            row.client.id = record.id;
+            row.client.name = record.name;
+            row.client.type = static_cast<domain::CustomerKind>(record.kind);
+            clients_.emplace(record.id, std::move(row));
+            clientNameToId_.insert(record.name, record.id);
+            nextClientId_ = std::max(nextClientId_, record.id + 1);
+            break;
+        }
+        case JournalRecordType::CloseAccount:
+            if (auto* row = accounts_.find(record.id)) closeAccount(*row);
+            break;
+        case JournalRecordType::EndOfDay:
+            break;
+    }
 }
 
 void BankSystem::logError(const char* message) {
-    std::fprintf(stderr, "%s\n", message);
+    log_.text(message).put('\n');
+}
+
+void BankSystem::respond(unsigned long long day,
+                         unsigned long long hour,
+                         unsigned long long minute,
+                         std::string_view message) {
+    stamp(out_, day, hour, minute).text(message).put('\n');
+}
+
+void BankSystem::exportColumns(unsigned long long day) {
+    // 每列一次遍历账户表，值直接流向文件 / Один проход по таблице на столбец, значения сразу идут в файл
+    std::array<std::string_view, domain::kCurrencyCount + 1> currencies{};
+    for (std::size_t c = 0; c < currencies.size(); ++c) currencies[c] = domain::toString(static_cast<domain::Currency>(c));
+    std::array<std::string_view, static_cast<std::size_t>(domain::AccountKind::Unknown) + 1> kinds{};
+    for (std::size_t k = 0; k < kinds.size(); ++k) kinds[k] = domain::toString(static_cast<domain::AccountKind>(k));
+    const auto today = [day](const AccountRow& row) { return row.minDay == day; };
+
+    columnar_.beginRowGroup(static_cast<std::uint32_t>(day), accounts_.size(), 9);
+    columnar_.beginColumn("account", ColumnType::UInt64);
+    accounts_.forEach([&](unsigned long long id, const AccountRow&) { columnar_.value<std::uint64_t>(id); });
+    columnar_.beginColumn("owner", ColumnType::UInt64);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value<std::uint64_t>(row.hasOwner ? row.owner : 0);
+    });
+    columnar_.beginColumn("balance", ColumnType::Int64);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) { columnar_.value(row.account.balance.thousandths); });
+    columnar_.beginColumn("currency", ColumnType::UInt8, currencies);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(static_cast<std::uint8_t>(row.account.currency));
+    });
+    columnar_.beginColumn("type", ColumnType::UInt8, kinds);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(static_cast<std::uint8_t>(row.account.type));
+    });
+    columnar_.beginColumn("active", ColumnType::UInt8);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(static_cast<std::uint8_t>(row.account.active));
+    });
+    columnar_.beginColumn("day_in", ColumnType::Int64);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(today(row) ? row.dayIn.thousandths : std::int64_t{0});
+    });
+    columnar_.beginColumn("day_out", ColumnType::Int64);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(today(row) ? row.dayOut.thousandths : std::int64_t{0});
+    });
+    columnar_.beginColumn("day_postings", ColumnType::UInt32);
+    accounts_.forEach([&](unsigned long long, const AccountRow& row) {
+        columnar_.value(today(row) ? row.dayPostings : std::uint32_t{0});
+    });
+    if (!columnar_.endRowGroup()) logError("Failed to write columnar export");
+}
+
+void BankSystem::enableBalanceHistory() {
+    history_ = std::make_shared<BalanceHistory>();
+    accounts_.forEach([this](unsigned long long id, const AccountRow& row) {
+        history_->record(id, currentTime_, row.account.balance);
+    });
+}
+
+std::optional<domain::Money> BankSystem::balanceAsOf(unsigned long long accountId, const domain::DateTime& time) const {
+    if (!history_) return std::nullopt;
+    return history_->asOf(accountId, time);
+}
+
+void BankSystem::publishSnapshot(bool final) {
+    auto snapshot = std::make_shared<BankSnapshot>();
+    snapshot->time = currentTime_;
+    snapshot->appeals = dayStats_.appeals;
+    snapshot->operations = dayStats_.operations;
+    snapshot->transfers = dayStats_.transfers;
+    snapshot->fees = dayStats_.fees;
+    snapshot->accounts.reserve(accounts_.size());
+    accounts_.forEach([&](unsigned long long id, const AccountRow& row) {
+        snapshot->accounts.push_back({id, row.owner, row.account.balance, row.account.currency, row.account.type,
+                                      row.hasOwner, row.account.active});
+    });
+    // 稠密部分已有序，只有溢出部分的账号需要排序 / Плотная часть уже упорядочена, сортировать нужно только переполнение
+    const auto byId = [](const AccountView& a, const AccountView& b) { return a.id < b.id; };
+    if (!std::is_sorted(snapshot->accounts.begin(), snapshot->accounts.end(), byId)) {
+        std::sort(snapshot->accounts.begin(), snapshot->accounts.end(), byId);
+    }
+    snapshot->index();
+    if (final) snapshot->history = history_;
+    queryService_->publish(std::move(snapshot));
+}
+
+void BankSystem::flushOutput() {
+    out_.flush();
+    log_.flush();
+    if (alerts_) alerts_->flush();
+    if (profile_) profile_->flush();
+    if (!ledger_.flush()) std::fprintf(stderr, "Failed to write ledger\n");
+}
+
+void BankSystem::defaultBank(unsigned long long day, unsigned long long hour, unsigned long long minute) {
+    halt(day, hour, minute, "Bank defaulted");
+}
+
+void BankSystem::defaultClient(unsigned long long day, unsigned long long hour, unsigned long long minute) {
+    halt(day, hour, minute, "Client defaulted");
+}
+
+void BankSystem::halt(unsigned long long day, unsigned long long hour, unsigned long long minute, const char* message) {
+    // 违约后不再处理任何事件；由调用方决定进程退出码。
+    // После дефолта события больше не обрабатываются; код завершения выбирает вызывающий.
+    respond(day, hour, minute, message);
+    flushOutput();
+    halted_ = true;
+}
+
+void BankSystem::reportAlerts(std::span<const RuleAlert> alerts,
+                              unsigned long long day,
+                              unsigned long long hour,
+                              unsigned long long minute) {
+    for (const auto& alert : alerts) {
+        stamp(*alerts_, day, hour, minute).text("Alert # ").number(alert.rule).text(" # ").text(toString(alert.kind))
+            .text(" # ").number(alert.clientId).text(" # ").number(alert.accountId).text(" # ").money(alert.amount).put('\n');
+    }
 }
 
 void BankSystem::logAccountTransfer(unsigned long long day,
@@ -754,19 +1980,28 @@ void BankSystem::logAccountTransfer(unsigned long long day,
                                     unsigned long long minute,
                                     unsigned long long fromAccount,
                                     unsigned long long toAccount,
-                                    double amount) const {
-    // stderr 日志格式严格遵循题目要求。
-    auto fmt = domain::formatMoney(amount);
-    std::fprintf(stderr,
-                 "%llu # %llu:%llu # %llu -> %llu # %s%llu.%03llu\n",
-                 day,
-                 hour,
-                 minute,
-                 fromAccount,
-                 toAccount,
-                 fmt.negative ? "-" : "",
-                 fmt.major,
-                 fmt.minor);
+                                    domain::Money amount) {
+    // 日志格式严格遵循题目要求："%llu # %llu:%llu # %llu -> %llu # %llu.%llu\n"
+    ++dayStats_.transfers;
+    stamp(log_, day, hour, minute).number(fromAccount).text(" -> ").number(toAccount).text(" # ").money(amount).put('\n');
+}
+
+void BankSystem::logAccountDeposit(unsigned long long day,
+                                   unsigned long long hour,
+                                   unsigned long long minute,
+                                   unsigned long long toAccount,
+                                   domain::Money amount) {
+    ++dayStats_.transfers;
+    stamp(log_, day, hour, minute).text("-> ").number(toAccount).text(" # ").money(amount).put('\n');
+}
+
+void BankSystem::logAccountWithdrawal(unsigned long long day,
+                                      unsigned long long hour,
+                                      unsigned long long minute,
+                                      unsigned long long fromAccount,
+                                      domain::Money amount) {
+    ++dayStats_.transfers;
+    stamp(log_, day, hour, minute).number(fromAccount).text(" -> # ").money(amount).put('\n');
 }
 
 }  // namespace bank
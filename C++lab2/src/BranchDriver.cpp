@@ -0,0 +1,111 @@
+#include "BranchDriver.hpp"
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <numeric>
+#include <system_error>
+
+namespace {
+/**
+ * @brief 运行单个分行 / Запуск одного отделения
+ *
+ * 异常只影响本分行，不能让工作线程终止整个进程。
+ * Исключение затрагивает только это отделение и не должно завершать весь процесс.
+ */
+void runBranch(const bank::BranchJob& job, bank::BranchResult& result) {
+    result.inputPath = job.inputPath;
+    std::FILE* out = std::fopen(job.outputPath.c_str(), "wb");
+    std::FILE* log = std::fopen(job.logPath.c_str(), "wb");
+    if (!out || !log) {
+        std::fprintf(stderr, "Branch %s: failed to open output files\n", job.inputPath.c_str());
+        if (out) std::fclose(out);
+        if (log) std::fclose(log);
+        return;
+    }
+    try {
+        bank::BankSystem branch(out, log);
+        branch.setParallelLoad(false);
+        result.loaded = branch.loadInitialData(job.inputPath.c_str());
+        if (result.loaded) {
+            result.completed = branch.run();
+            result.days = branch.dailyStats();
+        }
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "Branch %s: unhandled exception: %s\n", job.inputPath.c_str(), ex.what());
+        result.completed = false;
+    }
+    std::fclose(out);
+    std::fclose(log);
+}
+}  // namespace
+
+namespace bank {
+
+std::vector<BranchResult> runBranches(const std::vector<BranchJob>& jobs, std::size_t threads) {
+    std::vector<BranchResult> results(jobs.size());
+
+    // 最长处理时间优先：按输入大小降序提交 / Сначала самые долгие: отправка по убыванию размера ввода
+    std::vector<std::uintmax_t> sizes(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        std::error_code ec;
+        sizes[i] = std::filesystem::file_size(jobs[i].inputPath, ec);
+        if (ec) sizes[i] = 0;
+    }
+    std::vector<std::size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    ThreadPool pool(threads);
+    for (std::size_t index : order) {
+        pool.submit([&jobs, &results, index] { runBranch(jobs[index], results[index]); });
+    }
+    pool.wait();
+    return results;
+}
+
+std::vector<DaySummary> summarizeDays(const std::vector<BranchResult>& results) {
+    std::map<unsigned long long, DaySummary> byDay;
+    for (const auto& result : results) {
+        for (const auto& stats : result.days) {
+            auto& summary = byDay[stats.day];
+            summary.day = stats.day;
+            ++summary.branches;
+            summary.appeals += stats.appeals;
+            summary.operations += stats.operations;
+            summary.transfers += stats.transfers;
+            for (std::size_t c = 0; c < domain::kCurrencyCount; ++c) summary.fees[c] += stats.fees[c];
+            summary.customers += stats.customers;
+            summary.turnedAway += stats.turnedAway;
+            if (summary.waitHistogram.size() < stats.waitHistogram.size()) {
+                summary.waitHistogram.resize(stats.waitHistogram.size(), 0);
+            }
+            for (std::size_t m = 0; m < stats.waitHistogram.size(); ++m) summary.waitHistogram[m] += stats.waitHistogram[m];
+        }
+    }
+    std::vector<DaySummary> summary;
+    summary.reserve(byDay.size());
+    for (const auto& [day, entry] : byDay) summary.push_back(entry);
+    return summary;
+}
+
+void writeDaySummary(io::OutputSink& out, const std::vector<DaySummary>& summary) {
+    out.text("Day # Branches # Appeals # Operations # Transfers");
+    for (std::size_t c = 0; c < domain::kCurrencyCount; ++c) {
+        out.text(" # ").text(domain::toString(static_cast<domain::Currency>(c)));
+    }
+    out.text(" # Customers # Turned Away # Wait p50 # Wait p90 # Wait p99\n");
+    for (const auto& entry : summary) {
+        out.number(entry.day).text(" # ").number(entry.branches).text(" # ").number(entry.appeals)
+           .text(" # ").number(entry.operations).text(" # ").number(entry.transfers);
+        for (const auto& fee : entry.fees) out.text(" # ").money(fee);
+        out.text(" # ").number(entry.customers).text(" # ").number(entry.turnedAway);
+        for (const double q : {0.5, 0.9, 0.99}) out.text(" # ").number(waitPercentile(entry.waitHistogram, q));
+        out.put('\n');
+    }
+}
+
+}  // namespace bank
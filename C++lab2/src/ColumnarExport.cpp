@@ -0,0 +1,132 @@
+#include "ColumnarExport.hpp"
+
+#include "Journal.hpp"
+
+#include <algorithm>
+
+namespace bank {
+
+std::size_t columnWidth(ColumnType type) {
+    switch (type) {
+        case ColumnType::UInt8: return 1;
+        case ColumnType::UInt32: return 4;
+        case ColumnType::UInt64:
+        case ColumnType::Int64: return 8;
+    }
+    return 0;
+}
+
+const ColumnarColumn* ColumnarRowGroup::column(std::string_view name) const {
+    for (const auto& candidate : columns) {
+        if (candidate.name == name) return &candidate;
+    }
+    return nullptr;
+}
+
+ColumnarWriter::~ColumnarWriter() { close(); }
+
+bool ColumnarWriter::open(const std::string& path) {
+    close();
+    file_ = std::fopen(path.c_str(), "ab");
+    if (!file_) return false;
+    std::fseek(file_, 0, SEEK_END);
+    if (std::ftell(file_) == 0) {
+        raw(kFileMagic.data(), kFileMagic.size());
+        drain();
+    }
+    return !failed_;
+}
+
+void ColumnarWriter::beginRowGroup(std::uint32_t day, std::uint64_t rows, std::uint16_t columns) {
+    failed_ = false;
+    rows_ = rows;
+    value(kRowGroupMagic);
+    value(day);
+    value(rows);
+    value(columns);
+}
+
+void ColumnarWriter::beginColumn(std::string_view name, ColumnType type, std::span<const std::string_view> dictionary) {
+    text(name);
+    value(type);
+    value(dictionary.empty() ? ColumnEncoding::Plain : ColumnEncoding::Dictionary);
+    value(static_cast<std::uint16_t>(dictionary.size()));
+    for (const auto entry : dictionary) text(entry);
+    value(static_cast<std::uint64_t>(rows_ * columnWidth(type)));
+}
+
+bool ColumnarWriter::endRowGroup() {
+    drain();
+    if (file_ && std::fflush(file_) != 0) failed_ = true;
+    return !failed_;
+}
+
+void ColumnarWriter::close() {
+    if (!file_) return;
+    drain();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void ColumnarWriter::drain() {
+    if (used_ == 0) return;
+    if (file_ && std::fwrite(buffer_.data(), 1, used_, file_) != used_) failed_ = true;
+    used_ = 0;
+}
+
+void ColumnarWriter::raw(const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        if (used_ == buffer_.size()) drain();
+        const auto chunk = std::min(size, buffer_.size() - used_);
+        std::memcpy(buffer_.data() + used_, bytes, chunk);
+        used_ += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+void ColumnarWriter::text(std::string_view value) {
+    this->value(static_cast<std::uint16_t>(value.size()));
+    raw(value.data(), value.size());
+}
+
+bool readColumnar(const std::string& path, std::vector<ColumnarRowGroup>& groups) {
+    groups.clear();
+    std::string data;
+    if (!readWholeFile(path, data)) return false;
+    if (data.compare(0, ColumnarWriter::kFileMagic.size(), ColumnarWriter::kFileMagic) != 0) return false;
+    BinaryReader reader(data);
+    if (!reader.skip(ColumnarWriter::kFileMagic.size())) return false;
+    while (!reader.atEnd()) {
+        ColumnarRowGroup group;
+        std::uint32_t magic{};
+        std::uint16_t columns{};
+        if (!reader.get(magic) || magic != ColumnarWriter::kRowGroupMagic || !reader.get(group.day) ||
+            !reader.get(group.rows) || !reader.get(columns)) {
+            break;
+        }
+        bool complete = true;
+        for (std::uint16_t c = 0; c < columns && complete; ++c) {
+            ColumnarColumn column;
+            std::uint16_t dictionarySize{};
+            std::uint64_t bytes{};
+            complete = reader.getText(column.name) && reader.get(column.type) && reader.get(column.encoding) &&
+                       reader.get(dictionarySize);
+            for (std::uint16_t d = 0; d < dictionarySize && complete; ++d) {
+                complete = reader.getText(column.dictionary.emplace_back());
+            }
+            complete = complete && reader.get(bytes) && bytes == group.rows * columnWidth(column.type);
+            const auto start = reader.offset();
+            complete = complete && reader.skip(bytes);
+            if (!complete) break;
+            column.values.assign(data, start, bytes);
+            group.columns.push_back(std::move(column));
+        }
+        if (!complete) break;
+        groups.push_back(std::move(group));
+    }
+    return true;
+}
+
+}  // namespace bank
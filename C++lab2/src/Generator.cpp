@@ -0,0 +1,295 @@
+#include "Generator.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdarg>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace bank {
+
+namespace {
+constexpr domain::Currency kCurrencies[] = {
+    domain::Currency::RUB, domain::Currency::YUAN, domain::Currency::USD, domain::Currency::EUR};
+
+constexpr domain::CustomerKind kClientKinds[] = {
+    domain::CustomerKind::Individual, domain::CustomerKind::VipIndividual,
+    domain::CustomerKind::Legal, domain::CustomerKind::VipLegal};
+
+constexpr unsigned long long kFirstAccount = 100000;
+constexpr unsigned long long kFirstClient = 10000;
+constexpr unsigned long long kFirstDeposit = 20000;
+constexpr unsigned long long kFirstLoan = 30000;
+
+// 追加格式化文本，避免逐段构造临时字符串 / Дописывание форматированного текста без временных строк
+void appendf(std::string& out, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0) out.append(buffer, std::min<std::size_t>(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+}
+
+struct GeneratedClient {
+    std::string name;
+    domain::CustomerKind kind;
+    std::vector<unsigned long long> accounts;
+    unsigned long long loanAccount{0};
+};
+
+class InputWriter {
+public:
+    explicit InputWriter(const GeneratorConfig& config) : config_(config), random_(config.seed) {
+        weights_ = std::discrete_distribution<std::size_t>(config.mix.begin(), config.mix.end());
+    }
+
+    GeneratedInput run() {
+        writeHeader();
+        for (std::size_t day = 1; day <= config_.days; ++day) writeDay(day);
+        return std::move(result_);
+    }
+
+private:
+    template <typename T>
+    T uniform(T low, T high) {
+        return std::uniform_int_distribution<T>(low, high)(random_);
+    }
+
+    bool chance(double p) { return std::uniform_real_distribution<double>(0.0, 1.0)(random_) < p; }
+
+    domain::Currency anyCurrency() { return kCurrencies[uniform<std::size_t>(0, 3)]; }
+
+    void appendAmount(unsigned long long maxMajor) {
+        appendf(result_.text, "%llu.%03llu", uniform<unsigned long long>(1, maxMajor), uniform<unsigned long long>(0, 999));
+    }
+
+    void writeHeader() {
+        auto& out = result_.text;
+        const std::size_t clients = std::max<std::size_t>(config_.clients, 1);
+
+        // 每个客户 1-3 个账户；约 10% 的客户另有存款，约 5% 有贷款
+        // У клиента 1-3 счёта; примерно у 10% есть депозит, у 5% - кредит
+        clients_.resize(clients);
+        struct Row {
+            unsigned long long id;
+            domain::AccountKind kind;
+            unsigned long long balance;
+            domain::Currency currency;
+        };
+        std::vector<Row> accounts;
+        std::vector<std::pair<std::size_t, unsigned long long>> depositLinks;
+        std::vector<std::pair<std::size_t, unsigned long long>> loanLinks;
+        unsigned long long nextAccount = kFirstAccount;
+        for (std::size_t i = 0; i < clients; ++i) {
+            auto& client = clients_[i];
+            client.kind = kClientKinds[chance(0.8) ? (chance(0.7) ? 0 : 2) : (chance(0.5) ? 1 : 3)];
+            client.name = "Client" + std::to_string(i) + " Family" + std::to_string(i % 97) + " Pat";
+            const auto count = uniform<std::size_t>(1, 3);
+            for (std::size_t k = 0; k < count; ++k) {
+                const auto kind = chance(0.2) ? domain::AccountKind::Deposit : domain::AccountKind::Debit;
+                accounts.push_back({nextAccount, kind, uniform<unsigned long long>(100, 200000), anyCurrency()});
+                client.accounts.push_back(nextAccount++);
+            }
+            if (chance(0.05)) {
+                accounts.push_back({nextAccount, domain::AccountKind::Credit, 100000, domain::Currency::RUB});
+                loanLinks.emplace_back(i, nextAccount);
+                client.loanAccount = nextAccount;
+                client.accounts.push_back(nextAccount++);
+            }
+            if (chance(0.10)) depositLinks.emplace_back(i, client.accounts.front());
+        }
+        const unsigned long long bankAccounts = nextAccount;
+        for (std::size_t c = 0; c < std::size(kCurrencies); ++c) {
+            accounts.push_back({bankAccounts + c, domain::AccountKind::Debit, 900000000ULL, kCurrencies[c]});
+        }
+        accountCount_ = accounts.size();
+
+        appendf(out, "Accounts %zu\n", accounts.size());
+        for (const auto& row : accounts) {
+            appendf(out, "%llu # %s # %llu.000 # %s\n", row.id, domain::toString(row.kind), row.balance,
+                    domain::toString(row.currency));
+        }
+
+        static constexpr const char* kDepositTypes[] = {
+            "Compounded Daily Remaining", "Compounded Daily Min", "Compounded Monthly Remaining",
+            "Compounded Quarterly Min"};
+        appendf(out, "Debits %zu\n", depositLinks.size());
+        for (std::size_t i = 0; i < depositLinks.size(); ++i) {
+            appendf(out, "%llu # %e # %s # %llu # %llu\n", kFirstDeposit + i, 1.0 + uniform<int>(0, 80) / 10.0,
+                    kDepositTypes[uniform<std::size_t>(0, 3)], uniform<unsigned long long>(1, 3),
+                    chance(0.3) ? 0ULL : uniform<unsigned long long>(30, 365));
+        }
+        appendf(out, "Credits %zu\n", loanLinks.size());
+        for (std::size_t i = 0; i < loanLinks.size(); ++i) {
+            appendf(out, "%llu # %e # 100000.000 # Charged Daily\n", kFirstLoan + i, 8.0 + uniform<int>(0, 60) / 10.0);
+        }
+
+        appendf(out, "Clients %zu\n", clients_.size());
+        for (std::size_t i = 0; i < clients_.size(); ++i) {
+            appendf(out, "%llu # %s # %s\n", kFirstClient + i, clients_[i].name.c_str(), domain::toString(clients_[i].kind));
+        }
+
+        std::size_t debitRelations = 0;
+        for (const auto& client : clients_) debitRelations += client.accounts.size();
+        debitRelations -= loanLinks.size();
+        appendf(out, "Client Debit %zu\n", debitRelations);
+        std::size_t nextDepositLink = 0;
+        for (std::size_t i = 0; i < clients_.size(); ++i) {
+            for (auto account : clients_[i].accounts) {
+                if (account == clients_[i].loanAccount) continue;
+                unsigned long long deposit = 0;
+                if (nextDepositLink < depositLinks.size() && depositLinks[nextDepositLink].second == account) {
+                    deposit = kFirstDeposit + nextDepositLink++;
+                }
+                appendf(out, "%llu # %llu # %llu\n", kFirstClient + i, account, deposit);
+            }
+        }
+
+        appendf(out, "Bank Accounts %zu\n", std::size(kCurrencies));
+        for (std::size_t c = 0; c < std::size(kCurrencies); ++c) appendf(out, "%llu\n", bankAccounts + c);
+
+        appendf(out, "Client Credit %zu\n", loanLinks.size());
+        for (std::size_t i = 0; i < loanLinks.size(); ++i) {
+            appendf(out, "%llu # %llu # %llu\n", kFirstClient + loanLinks[i].first, loanLinks[i].second, kFirstLoan + i);
+        }
+
+        // 岗位数量随日到访量增长 / Число окон растёт с числом обращений в день
+        const auto staff = std::max<std::size_t>(1, config_.appealsPerDay / 80);
+        out += "Work Places 4\n";
+        appendf(out, "Client Manager # %zu\n", staff);
+        appendf(out, "Cash Desk # %zu\n", staff);
+        appendf(out, "Currency Exchange # %zu\n", std::max<std::size_t>(1, staff / 2));
+        appendf(out, "VIP Client Manager # %zu\n", std::max<std::size_t>(1, staff / 2));
+
+        out += "Exchange Rates 4\n";
+        out += "USD # RUB # 7.550000e+01\n";
+        out += "EUR # RUB # 8.520000e+01\n";
+        out += "YUAN # RUB # 1.050000e+01\n";
+        out += "RUB # USD # 1.324503e-02\n";
+    }
+
+    unsigned long long pickAccount(const GeneratedClient& client) {
+        // 大多是自己的账户，偶尔是别人的或不存在的 / Обычно свой счёт, иногда чужой или несуществующий
+        if (chance(0.95)) return client.accounts[uniform<std::size_t>(0, client.accounts.size() - 1)];
+        return kFirstAccount + uniform<unsigned long long>(0, accountCount_ + 16);
+    }
+
+    void writeOperation(domain::Operation op, const GeneratedClient* client) {
+        auto& out = result_.text;
+        ++result_.operations[static_cast<std::size_t>(op)];
+        out += domain::toString(op);
+        switch (op) {
+            case domain::Operation::BalanceInquiry:
+            case domain::Operation::CloseAccount:
+                appendf(out, " # %llu\n", pickAccount(*client));
+                break;
+            case domain::Operation::CreateAccount:
+                appendf(out, " # %s\n", domain::toString(anyCurrency()));
+                break;
+            case domain::Operation::WithdrawFunds:
+            case domain::Operation::TopUpFunds:
+                appendf(out, " # %llu # ", pickAccount(*client));
+                appendAmount(op == domain::Operation::WithdrawFunds ? 500 : 5000);
+                out += '\n';
+                break;
+            case domain::Operation::CurrencyExchange: {
+                const auto from = uniform<std::size_t>(0, 3);
+                const auto to = (from + uniform<std::size_t>(1, 3)) % 4;
+                appendf(out, " # %s -> %s # ", domain::toString(kCurrencies[from]), domain::toString(kCurrencies[to]));
+                appendAmount(1000);
+                out += '\n';
+                break;
+            }
+            case domain::Operation::RequestDebitCard:
+                appendf(out, " # %s # Compounded Daily Remaining\n", domain::toString(anyCurrency()));
+                break;
+            case domain::Operation::Unknown:
+                out += '\n';
+                break;
+        }
+    }
+
+    void writeDay(std::size_t day) {
+        auto& out = result_.text;
+        appendf(out, "%zu # 7:55 # Start of Bank Day\n", day);
+        ++result_.events;
+
+        std::vector<unsigned> arrivals(config_.appealsPerDay);
+        for (auto& minute : arrivals) minute = uniform<unsigned>(8 * 60, 19 * 60 - 1);
+        std::sort(arrivals.begin(), arrivals.end());
+
+        for (std::size_t a = 0; a < arrivals.size(); ++a) {
+            const auto operations = config_.maxOperations == 0 ? 0 : uniform<std::size_t>(1, config_.maxOperations);
+            ++result_.events;
+            if (chance(config_.newClientShare)) {
+                // 新客户只能开户 / Новый клиент может только открыть счёт
+                appendf(out, "%zu # %u:%u # Personal Appeal # Guest%zux%zu Person # %s # %zu\n", day, arrivals[a] / 60,
+                        arrivals[a] % 60, day, a, chance(0.8) ? "Individual" : "Legal Entity", operations);
+                for (std::size_t k = 0; k < operations; ++k) writeOperation(domain::Operation::CreateAccount, nullptr);
+                continue;
+            }
+            const auto& client = clients_[uniform<std::size_t>(0, clients_.size() - 1)];
+            const bool legal = client.kind == domain::CustomerKind::Legal || client.kind == domain::CustomerKind::VipLegal;
+            appendf(out, "%zu # %u:%u # Personal Appeal # %s # %s # %zu\n", day, arrivals[a] / 60, arrivals[a] % 60,
+                    client.name.c_str(), legal ? "Legal Entity" : "Individual", operations);
+            for (std::size_t k = 0; k < operations; ++k) {
+                writeOperation(static_cast<domain::Operation>(weights_(random_)), &client);
+            }
+        }
+
+        appendf(out, "%zu # 19:00 # End of Bank Day\n", day);
+        ++result_.events;
+    }
+
+    const GeneratorConfig& config_;
+    std::mt19937_64 random_;
+    std::discrete_distribution<std::size_t> weights_;
+    std::vector<GeneratedClient> clients_;
+    std::size_t accountCount_{0};
+    GeneratedInput result_;
+};
+}  // namespace
+
+const char* operationKey(domain::Operation op) {
+    switch (op) {
+        case domain::Operation::BalanceInquiry: return "balance";
+        case domain::Operation::CreateAccount: return "create";
+        case domain::Operation::CloseAccount: return "close";
+        case domain::Operation::WithdrawFunds: return "withdraw";
+        case domain::Operation::TopUpFunds: return "topup";
+        case domain::Operation::CurrencyExchange: return "exchange";
+        case domain::Operation::RequestDebitCard: return "card";
+        case domain::Operation::Unknown: default: return "unknown";
+    }
+}
+
+bool parseOperationMix(std::string_view text, OperationMix& mix) {
+    OperationMix parsed{};
+    while (!text.empty()) {
+        const auto comma = text.find(',');
+        const auto item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        const auto equals = item.find('=');
+        if (equals == std::string_view::npos) return false;
+        const auto key = item.substr(0, equals);
+        const auto value = item.substr(equals + 1);
+        std::size_t index = 0;
+        while (index < domain::kOperationCount && key != operationKey(static_cast<domain::Operation>(index))) ++index;
+        if (index == domain::kOperationCount) return false;
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed[index]);
+        if (ec != std::errc{} || end != value.data() + value.size()) return false;
+    }
+    if (std::accumulate(parsed.begin(), parsed.end(), 0ULL) == 0) return false;
+    mix = parsed;
+    return true;
+}
+
+GeneratedInput generateBranchInput(const GeneratorConfig& config) {
+    return InputWriter(config).run();
+}
+
+}  // namespace bank
@@ -0,0 +1,199 @@
+#include "Input.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// 与 "%99[a-zA-Z0-9/_ ]" 相同的字符集 / Тот же набор символов, что и "%99[a-zA-Z0-9/_ ]"
+bool isTextChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '/' || c == '_' || c == ' ';
+}
+
+constexpr std::size_t kMaxTextLength = 99;
+}  // namespace
+
+namespace io {
+
+MappedInput::~MappedInput() { release(); }
+
+MappedInput::MappedInput(MappedInput&& other) noexcept { *this = std::move(other); }
+
+MappedInput& MappedInput::operator=(MappedInput&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    mapped_ = other.mapped_;
+    fallback_ = std::move(other.fallback_);
+    size_ = other.size_;
+    data_ = mapped_ ? other.data_ : fallback_.data();
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+    return *this;
+}
+
+void MappedInput::release() {
+#if !defined(_WIN32)
+    if (mapped_ && data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    fallback_.clear();
+}
+
+bool MappedInput::open(const char* path) {
+    release();
+#if !defined(_WIN32)
+    // 普通文件直接 mmap；管道/终端或已被部分读取的 stdin 退回到整体读取。
+    const int fd = path ? ::open(path, O_RDONLY) : STDIN_FILENO;
+    if (fd < 0) return false;
+    struct stat info {};
+    const bool regular = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0;
+    const bool atStart = path || ::lseek(fd, 0, SEEK_CUR) == 0;
+    if (regular && atStart) {
+        const auto length = static_cast<std::size_t>(info.st_size);
+        void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::madvise(addr, length, MADV_SEQUENTIAL);
+            if (path) ::close(fd);
+            mapped_ = true;
+            data_ = static_cast<const char*>(addr);
+            size_ = length;
+            return true;
+        }
+    }
+    if (path) ::close(fd);
+#endif
+    std::FILE* file = path ? std::fopen(path, "rb") : stdin;
+    if (!file) return false;
+    const bool ok = readAll(file);
+    if (path) std::fclose(file);
+    return ok;
+}
+
+bool MappedInput::readAll(std::FILE* file) {
+    char chunk[1 << 16];
+    std::size_t got = 0;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        fallback_.append(chunk, got);
+    }
+    if (std::ferror(file)) return false;
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+    return true;
+}
+
+bool LineCursor::next(std::string_view& line) {
+    if (pos_ >= text_.size()) return false;
+    const char* begin = text_.data() + pos_;
+    const std::size_t rest = text_.size() - pos_;
+    const void* nl = std::memchr(begin, '\n', rest);
+    std::size_t length = nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - begin) : rest;
+    pos_ += nl ? length + 1 : length;
+    while (length > 0 && begin[length - 1] == '\r') --length;
+    line = std::string_view(begin, length);
+    return true;
+}
+
+bool LineCursor::nextNonBlank(std::string_view& line) {
+    while (next(line)) {
+        for (char c : line) {
+            if (!isSpace(c)) return true;
+        }
+    }
+    return false;
+}
+
+bool locateSection(LineCursor& cursor, std::string_view header, Section& section) {
+    std::string_view line;
+    if (!cursor.nextNonBlank(line)) return false;
+    // 允许行首空白（上一条 scanf 格式末尾的 "\n" 会吞掉它们）。
+    while (!line.empty() && isSpace(line.front())) line.remove_prefix(1);
+    if (line.substr(0, header.size()) != header) return false;
+    FieldReader reader(line.substr(header.size()));
+    unsigned long long count{};
+    if (!reader.readUnsigned(count)) return false;
+
+    section.header = header;
+    section.count = count;
+    const std::size_t bodyBegin = cursor.offset();
+    std::size_t bodyEnd = bodyBegin;
+    std::string_view row;
+    for (unsigned long long i = 0; i < count && cursor.nextNonBlank(row); ++i) {
+        bodyEnd = cursor.offset();
+    }
+    section.body = cursor.slice(bodyBegin, bodyEnd);
+    return true;
+}
+
+void FieldReader::skipSpaces() {
+    while (pos_ < line_.size() && isSpace(line_[pos_])) ++pos_;
+}
+
+bool FieldReader::literal(char c) {
+    skipSpaces();
+    if (pos_ >= line_.size() || line_[pos_] != c) return false;
+    ++pos_;
+    return true;
+}
+
+bool FieldReader::separator() {
+    if (!literal('#')) return false;
+    skipSpaces();
+    return true;
+}
+
+bool FieldReader::readUnsigned(unsigned long long& value) {
+    skipSpaces();
+    if (pos_ < line_.size() && line_[pos_] == '+') ++pos_;
+    const char* first = line_.data() + pos_;
+    const char* last = line_.data() + line_.size();
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{}) return false;
+    pos_ += static_cast<std::size_t>(ptr - first);
+    return true;
+}
+
+bool FieldReader::readDouble(double& value) {
+    skipSpaces();
+    if (pos_ < line_.size() && line_[pos_] == '+') ++pos_;
+    const char* first = line_.data() + pos_;
+    const char* last = line_.data() + line_.size();
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{}) return false;
+    pos_ += static_cast<std::size_t>(ptr - first);
+    return true;
+}
+
+bool FieldReader::readMoney(unsigned long long& major, unsigned long long& minor) {
+    // "%llu.%llu"：整数部分与小数部分分别按无符号整数读取。
+    if (!readUnsigned(major)) return false;
+    if (pos_ >= line_.size() || line_[pos_] != '.') return false;
+    ++pos_;
+    return readUnsigned(minor);
+}
+
+bool FieldReader::readText(std::string_view& value) {
+    const std::size_t begin = pos_;
+    while (pos_ < line_.size() && pos_ - begin < kMaxTextLength && isTextChar(line_[pos_])) ++pos_;
+    if (pos_ == begin) return false;
+    value = line_.substr(begin, pos_ - begin);
+    return true;
+}
+
+}  // namespace io
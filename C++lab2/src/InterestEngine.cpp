@@ -0,0 +1,192 @@
+#include "InterestEngine.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace bank {
+
+namespace {
+std::string_view trimRight(std::string_view text) {
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    return text;
+}
+
+bool consumePrefix(std::string_view& text, std::string_view prefix) {
+    if (text.substr(0, prefix.size()) != prefix) return false;
+    text.remove_prefix(prefix.size());
+    return true;
+}
+
+// 题目里存款写作 "Semi-Annually"，贷款写作 "Semi-annually" / В задаче "Semi-Annually" у депозитов и "Semi-annually" у кредитов
+bool consumePeriod(std::string_view& text, AccrualPeriod& period) {
+    struct Word {
+        std::string_view text;
+        AccrualPeriod period;
+    };
+    constexpr Word kWords[] = {
+        {"Daily", AccrualPeriod::Daily},
+        {"Monthly", AccrualPeriod::Monthly},
+        {"Quarterly", AccrualPeriod::Quarterly},
+        {"Semi-Annually", AccrualPeriod::SemiAnnual},
+        {"Semi-annually", AccrualPeriod::SemiAnnual},
+        {"Annually", AccrualPeriod::Annual},
+    };
+    for (const auto& word : kWords) {
+        if (consumePrefix(text, word.text)) {
+            period = word.period;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void permute(std::vector<T>& column, const std::vector<std::size_t>& order) {
+    std::vector<T> sorted;
+    sorted.reserve(column.size());
+    for (auto index : order) sorted.push_back(column[index]);
+    column = std::move(sorted);
+}
+
+template <typename T>
+void keepIf(std::vector<T>& column, const std::vector<std::uint8_t>& keep) {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < column.size(); ++i) {
+        if (keep[i]) column[out++] = column[i];
+    }
+    column.resize(out);
+}
+
+// 与 Money::fromDouble(Money::toDouble() * rate) 相同的舍入，只保留正值
+// Округление как у Money::fromDouble(Money::toDouble() * rate), только положительные значения
+inline std::int64_t roundPositive(std::int64_t thousandths, double rate) {
+    const double units = static_cast<double>(thousandths) / static_cast<double>(domain::Money::kScale) * rate;
+    const auto rounded = static_cast<std::int64_t>(units * 10000.0 + 5.0) / 10;
+    return units > 0.0 ? rounded : 0;
+}
+}  // namespace
+
+AccrualTerms parseDepositTerms(std::string_view type) {
+    AccrualTerms terms{};
+    type = trimRight(type);
+    if (!consumePrefix(type, "Compounded ") || !consumePeriod(type, terms.period)) return terms;
+    if (type == " Remaining") {
+        terms.valid = true;
+    } else if (type == " Min") {
+        terms.valid = true;
+        terms.minimum = true;
+    }
+    return terms;
+}
+
+AccrualTerms parseLoanTerms(std::string_view type) {
+    AccrualTerms terms{};
+    type = trimRight(type);
+    terms.valid = consumePrefix(type, "Charged ") && consumePeriod(type, terms.period) && type.empty();
+    return terms;
+}
+
+void InterestEngine::clear() {
+    deposits_ = {};
+    loans_ = {};
+    nextMaturity_ = kOpenEnded;
+}
+
+void InterestEngine::addDeposit(unsigned long long accountId, const domain::Deposit& deposit) {
+    const auto terms = parseDepositTerms(deposit.type);
+    if (!terms.valid || !(deposit.rate > 0.0)) return;
+    auto& book = deposits(terms.period);
+    book.productId.push_back(deposit.id);
+    book.account.push_back(accountId);
+    book.rate.push_back(deposit.rate / 100.0 / periodsPerYear(terms.period));
+    book.principal.push_back(0);
+    book.opensOn.push_back(deposit.createdDay);
+    // 期限为 0 视为不定期 / Нулевой срок - депозит до востребования
+    const auto maturesOn = deposit.durationDays == 0 ? kOpenEnded : deposit.createdDay + deposit.durationDays;
+    book.maturesOn.push_back(maturesOn);
+    book.minimum.push_back(terms.minimum ? 1 : 0);
+    nextMaturity_ = std::min(nextMaturity_, maturesOn);
+}
+
+void InterestEngine::addLoan(unsigned long long accountId, const domain::Loan& loan) {
+    const auto terms = parseLoanTerms(loan.type);
+    if (!terms.valid || !(loan.rate > 0.0)) return;
+    auto& book = loans(terms.period);
+    book.productId.push_back(loan.id);
+    book.account.push_back(accountId);
+    book.rate.push_back(loan.rate / 100.0 / periodsPerYear(terms.period));
+    book.principal.push_back(loan.amount.thousandths);
+    book.opensOn.push_back(0);
+    book.maturesOn.push_back(kOpenEnded);
+    book.minimum.push_back(0);
+}
+
+void InterestEngine::reorder(Book& book) {
+    std::vector<std::size_t> order(book.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&book](std::size_t a, std::size_t b) {
+        return book.productId[a] < book.productId[b];
+    });
+    permute(book.productId, order);
+    permute(book.account, order);
+    permute(book.rate, order);
+    permute(book.principal, order);
+    permute(book.opensOn, order);
+    permute(book.maturesOn, order);
+    permute(book.minimum, order);
+    book.base.assign(book.size(), 0);
+    book.interest.assign(book.size(), 0);
+}
+
+void InterestEngine::finalize() {
+    for (auto& book : deposits_) reorder(book);
+    for (auto& book : loans_) reorder(book);
+}
+
+void InterestEngine::retireMatured(unsigned long long day) {
+    if (day < nextMaturity_) return;
+    nextMaturity_ = kOpenEnded;
+    for (auto& book : deposits_) {
+        std::vector<std::uint8_t> keep(book.size());
+        for (std::size_t i = 0; i < book.size(); ++i) {
+            keep[i] = book.maturesOn[i] > day ? 1 : 0;
+            if (keep[i]) nextMaturity_ = std::min(nextMaturity_, book.maturesOn[i]);
+        }
+        keepIf(book.productId, keep);
+        keepIf(book.account, keep);
+        keepIf(book.rate, keep);
+        keepIf(book.principal, keep);
+        keepIf(book.opensOn, keep);
+        keepIf(book.maturesOn, keep);
+        keepIf(book.minimum, keep);
+        book.base.resize(book.size());
+        book.interest.resize(book.size());
+    }
+}
+
+void InterestEngine::computeDeposits(Book& book, unsigned long long day) {
+    const std::size_t n = book.size();
+    const std::int64_t* base = book.base.data();
+    const double* rate = book.rate.data();
+    const unsigned long long* opensOn = book.opensOn.data();
+    const unsigned long long* maturesOn = book.maturesOn.data();
+    std::int64_t* interest = book.interest.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool active = opensOn[i] <= day && day < maturesOn[i];
+        interest[i] = active ? roundPositive(base[i], rate[i]) : 0;
+    }
+}
+
+void InterestEngine::computeLoans(Book& book) {
+    const std::size_t n = book.size();
+    const std::int64_t* base = book.base.data();
+    const std::int64_t* principal = book.principal.data();
+    const double* rate = book.rate.data();
+    std::int64_t* interest = book.interest.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        interest[i] = roundPositive(principal[i] - base[i], rate[i]);
+    }
+}
+
+}  // namespace bank
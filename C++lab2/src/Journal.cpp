@@ -0,0 +1,180 @@
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace bank {
+
+namespace {
+// 缓冲写出后强制落盘 / Сброс буферов и принудительная запись на диск
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return ::_commit(::_fileno(file)) == 0;
+#else
+    return ::fsync(::fileno(file)) == 0;
+#endif
+}
+}  // namespace
+
+void BinaryWriter::putText(std::string_view text) {
+    const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(text.size(), UINT16_MAX));
+    put(length);
+    data_.append(text.data(), length);
+}
+
+bool BinaryReader::getText(std::string& text) {
+    std::uint16_t length{};
+    if (!get(length) || data_.size() - pos_ < length) return false;
+    text.assign(data_.data() + pos_, length);
+    pos_ += length;
+    return true;
+}
+
+Journal::~Journal() { close(); }
+
+bool Journal::open(const std::string& path, std::size_t validBytes) {
+    close();
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        std::filesystem::resize_file(path, validBytes, ec);
+        if (ec) return false;
+    }
+    file_ = std::fopen(path.c_str(), "ab");
+    path_ = path;
+    pending_.clear();
+    return file_ != nullptr;
+}
+
+void Journal::balance(unsigned long long accountId, domain::Money delta) {
+    pending_.put(JournalRecordType::Balance);
+    pending_.put(accountId);
+    pending_.put(delta.thousandths);
+}
+
+void Journal::openAccount(unsigned long long accountId,
+                          unsigned long long clientId,
+                          domain::Currency currency,
+                          domain::AccountKind kind,
+                          domain::Money balance) {
+    pending_.put(JournalRecordType::OpenAccount);
+    pending_.put(accountId);
+    pending_.put(clientId);
+    pending_.put(static_cast<std::uint8_t>(currency));
+    pending_.put(static_cast<std::uint8_t>(kind));
+    pending_.put(balance.thousandths);
+}
+
+void Journal::newClient(unsigned long long clientId, domain::CustomerKind kind, std::string_view name) {
+    pending_.put(JournalRecordType::NewClient);
+    pending_.put(clientId);
+    pending_.put(static_cast<std::uint8_t>(kind));
+    pending_.putText(name);
+}
+
+void Journal::closeAccount(unsigned long long accountId) {
+    pending_.put(JournalRecordType::CloseAccount);
+    pending_.put(accountId);
+}
+
+bool Journal::commitDay(unsigned long long day, std::size_t inputOffset) {
+    if (!file_) return false;
+    pending_.put(JournalRecordType::EndOfDay);
+    pending_.put(day);
+    pending_.put(static_cast<unsigned long long>(inputOffset));
+    const auto& data = pending_.data();
+    const bool written = std::fwrite(data.data(), 1, data.size(), file_) == data.size();
+    pending_.clear();
+    return written && syncFile(file_);
+}
+
+bool Journal::truncate() {
+    if (!file_) return false;
+    std::fclose(file_);
+    file_ = std::fopen(path_.c_str(), "wb");
+    return file_ != nullptr && syncFile(file_);
+}
+
+void Journal::close() {
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    pending_.clear();
+}
+
+bool readJournal(const std::string& path, std::vector<JournalRecord>& records, std::size_t& validBytes) {
+    records.clear();
+    validBytes = 0;
+    std::string data;
+    if (!readWholeFile(path, data)) return !std::filesystem::exists(path);
+
+    BinaryReader reader(data);
+    std::size_t committedRecords = 0;
+    while (!reader.atEnd()) {
+        JournalRecord record{};
+        bool ok = reader.get(record.type);
+        switch (record.type) {
+            case JournalRecordType::Balance:
+                ok = ok && reader.get(record.id) && reader.get(record.amount.thousandths);
+                break;
+            case JournalRecordType::OpenAccount:
+                ok = ok && reader.get(record.id) && reader.get(record.other) &&
+                     reader.get(record.currency) && reader.get(record.kind) && reader.get(record.amount.thousandths);
+                break;
+            case JournalRecordType::NewClient:
+                ok = ok && reader.get(record.id) && reader.get(record.kind) && reader.getText(record.name);
+                break;
+            case JournalRecordType::EndOfDay:
+                ok = ok && reader.get(record.id) && reader.get(record.other);
+                break;
+            case JournalRecordType::CloseAccount:
+                ok = ok && reader.get(record.id);
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        // 不完整或损坏的尾部：到此为止 / Неполный или повреждённый хвост: дальше не читаем
+        if (!ok) break;
+        const bool commit = record.type == JournalRecordType::EndOfDay;
+        records.push_back(std::move(record));
+        if (commit) {
+            committedRecords = records.size();
+            validBytes = reader.offset();
+        }
+    }
+    records.resize(committedRecords);
+    return true;
+}
+
+bool writeFileAtomically(const std::string& path, const std::string& data) {
+    const std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size() && syncFile(file);
+    std::fclose(file);
+    if (!written) return false;
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    return !ec;
+}
+
+bool readWholeFile(const std::string& path, std::string& data) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    data.clear();
+    char chunk[1 << 16];
+    std::size_t got = 0;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) data.append(chunk, got);
+    std::fclose(file);
+    return true;
+}
+
+}  // namespace bank
@@ -0,0 +1,58 @@
+#include "Ledger.hpp"
+
+namespace bank {
+
+Ledger::~Ledger() { close(); }
+
+bool Ledger::open(const std::string& path) {
+    close();
+    file_ = std::fopen(path.c_str(), "ab");
+    return file_ != nullptr;
+}
+
+void Ledger::record(std::size_t count, unsigned long long day, unsigned long long hour, unsigned long long minute) {
+    if (file_) {
+        const auto minuteOfDay = static_cast<std::uint16_t>(hour * 60 + minute);
+        for (std::size_t i = 0; i < count && i < batch_.size(); ++i) {
+            records_.put(static_cast<std::uint32_t>(day));
+            records_.put(minuteOfDay);
+            records_.put(batch_[i].from);
+            records_.put(batch_[i].to);
+            records_.put(batch_[i].amount.thousandths);
+        }
+    }
+    batch_.clear();
+}
+
+bool Ledger::flush() {
+    if (!file_) return true;
+    const auto& data = records_.data();
+    const bool written = std::fwrite(data.data(), 1, data.size(), file_) == data.size() && std::fflush(file_) == 0;
+    records_.clear();
+    return written;
+}
+
+void Ledger::close() {
+    if (!file_) return;
+    flush();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+bool readLedger(const std::string& path, std::vector<LedgerRecord>& records) {
+    records.clear();
+    std::string data;
+    if (!readWholeFile(path, data)) return false;
+    BinaryReader reader(data);
+    while (!reader.atEnd()) {
+        LedgerRecord record{};
+        if (!reader.get(record.day) || !reader.get(record.minuteOfDay) || !reader.get(record.from) ||
+            !reader.get(record.to) || !reader.get(record.amount.thousandths)) {
+            break;
+        }
+        records.push_back(record);
+    }
+    return true;
+}
+
+}  // namespace bank
@@ -0,0 +1,38 @@
+#include "Output.hpp"
+
+#include <algorithm>
+
+namespace io {
+
+OutputSink::OutputSink(std::FILE* file, std::size_t capacity)
+    : file_(file), storage_(std::max<std::size_t>(capacity, 64)), data_(storage_.data()), capacity_(storage_.size()) {}
+
+OutputSink::~OutputSink() { flush(); }
+
+void OutputSink::flush() {
+    if (!file_ || size_ == 0) return;
+    std::fwrite(data_, 1, size_, file_);
+    std::fflush(file_);
+    size_ = 0;
+}
+
+bool OutputSink::grow(std::size_t n) {
+    if (file_) {
+        // 文件通道：先写出，超大的单次写入由调用方直接写穿。
+        flush();
+        return capacity_ >= n;
+    }
+    // 内存通道：按倍数扩容 / Канал в памяти: увеличиваем ёмкость кратно
+    const std::size_t next = std::max(capacity_ * 2, size_ + n);
+    storage_.resize(next);
+    data_ = storage_.data();
+    capacity_ = next;
+    return true;
+}
+
+OutputSink& OutputSink::writeThrough(std::string_view value) {
+    std::fwrite(value.data(), 1, value.size(), file_);
+    return *this;
+}
+
+}  // namespace io
@@ -0,0 +1,262 @@
+#include "QueryService.hpp"
+
+#include "Input.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace bank {
+
+void BankSnapshot::index() {
+    byOwner.clear();
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        if (accounts[i].hasOwner) byOwner.push_back(static_cast<std::uint32_t>(i));
+    }
+    // accounts 已按账号排序，稳定排序保持同一所有者内的账号顺序
+    // accounts уже по номерам, устойчивая сортировка сохраняет их порядок внутри владельца
+    std::stable_sort(byOwner.begin(), byOwner.end(), [this](std::uint32_t a, std::uint32_t b) {
+        return accounts[a].owner < accounts[b].owner;
+    });
+}
+
+const AccountView* BankSnapshot::find(unsigned long long id) const {
+    auto it = std::lower_bound(accounts.begin(), accounts.end(), id,
+                               [](const AccountView& account, unsigned long long key) { return account.id < key; });
+    return it != accounts.end() && it->id == id ? &*it : nullptr;
+}
+
+QueryService::QueryService(std::size_t threads)
+    : threads_(threads != 0 ? threads : std::max<std::size_t>(1, std::thread::hardware_concurrency())) {}
+
+QueryService::~QueryService() { stop(); }
+
+void QueryService::publish(std::shared_ptr<const BankSnapshot> snapshot) {
+    current_.store(std::move(snapshot), std::memory_order_release);
+    lastPublish_ = std::chrono::steady_clock::now();
+}
+
+namespace {
+io::OutputSink& stamp(io::OutputSink& reply, const BankSnapshot& snapshot) {
+    return reply.number(snapshot.time.day).text(" # ").number(snapshot.time.hour).put(':').number(snapshot.time.minute).text(" # ");
+}
+
+/// 请求以 name 开头时返回其后的参数 / Аргументы запроса, если он начинается с name
+bool matchRequest(std::string_view request, std::string_view name, io::FieldReader& fields) {
+    if (request.substr(0, name.size()) != name) return false;
+    fields = io::FieldReader(request.substr(name.size()));
+    return true;
+}
+}  // namespace
+
+void QueryService::answer(std::string_view request, io::OutputSink& reply) const {
+    const auto snapshot = this->snapshot();
+    if (!snapshot) {
+        reply.text("Not ready\n");
+        return;
+    }
+    io::FieldReader fields(request);
+    unsigned long long id{};
+    if (matchRequest(request, "Balance Inquiry", fields)) {
+        if (!fields.separator() || !fields.readUnsigned(id)) {
+            stamp(reply, *snapshot).text("Client error. Unknown account\n");
+            return;
+        }
+        const auto* account = snapshot->find(id);
+        if (!account) {
+            stamp(reply, *snapshot).text("Client error. Unknown account\n");
+        } else if (!account->active) {
+            stamp(reply, *snapshot).text("Account closed\n");
+        } else {
+            stamp(reply, *snapshot).text("Balance of ").number(id).text(" # ").money(account->balance)
+                .text(" # ").text(domain::toString(account->currency)).put('\n');
+        }
+    } else if (matchRequest(request, "Client Accounts", fields)) {
+        if (!fields.separator() || !fields.readUnsigned(id)) {
+            stamp(reply, *snapshot).text("Client error. Unknown client\n");
+            return;
+        }
+        const auto& accounts = snapshot->accounts;
+        auto it = std::lower_bound(snapshot->byOwner.begin(), snapshot->byOwner.end(), id,
+                                   [&](std::uint32_t index, unsigned long long key) { return accounts[index].owner < key; });
+        stamp(reply, *snapshot).text("Accounts of ").number(id);
+        for (; it != snapshot->byOwner.end() && accounts[*it].owner == id; ++it) {
+            const auto& account = accounts[*it];
+            if (!account.active) continue;
+            reply.text(" # ").number(account.id).text(" # ").money(account.balance)
+                .text(" # ").text(domain::toString(account.currency));
+        }
+        reply.put('\n');
+    } else if (matchRequest(request, "Balance As Of", fields)) {
+        domain::DateTime time{};
+        if (!fields.separator() || !fields.readUnsigned(id) || !fields.separator() || !fields.readUnsigned(time.day) ||
+            !fields.separator() || !fields.readUnsigned(time.hour) || !fields.literal(':') || !fields.readUnsigned(time.minute)) {
+            stamp(reply, *snapshot).text("Client error. Unknown account\n");
+            return;
+        }
+        if (!snapshot->history) {
+            stamp(reply, *snapshot).text("History not available\n");
+            return;
+        }
+        const auto* account = snapshot->find(id);
+        const auto balance = account ? snapshot->history->asOf(id, time) : std::nullopt;
+        if (!account) {
+            stamp(reply, *snapshot).text("Client error. Unknown account\n");
+        } else if (!balance) {
+            stamp(reply, *snapshot).text("No balance as of that time\n");
+        } else {
+            stamp(reply, *snapshot).text("Balance of ").number(id).text(" as of ").number(time.day).text(" # ")
+                .number(time.hour).put(':').number(time.minute).text(" # ").money(*balance)
+                .text(" # ").text(domain::toString(account->currency)).put('\n');
+        }
+    } else if (matchRequest(request, "Day Stats", fields)) {
+        stamp(reply, *snapshot).text("Day Stats # ").number(snapshot->appeals).text(" # ").number(snapshot->operations)
+            .text(" # ").number(snapshot->transfers);
+        for (std::size_t c = 0; c < domain::kCurrencyCount; ++c) {
+            reply.text(" # ").money(snapshot->fees[c]).put(' ').text(domain::toString(static_cast<domain::Currency>(c)));
+        }
+        reply.put('\n');
+    } else {
+        reply.text("Unknown request\n");
+    }
+}
+
+#if !defined(_WIN32)
+
+bool QueryService::start(const std::string& socketPath) {
+    stop();
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::fprintf(stderr, "Socket path too long: %s\n", socketPath.c_str());
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0 || ::fcntl(listenFd_, F_SETFL, O_NONBLOCK) != 0 || ::pipe(wakeFds_) != 0) {
+        std::fprintf(stderr, "Cannot create query socket: %s\n", std::strerror(errno));
+        stop();
+        return false;
+    }
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd_, SOMAXCONN) != 0) {
+        std::fprintf(stderr, "Cannot listen on %s: %s\n", socketPath.c_str(), std::strerror(errno));
+        stop();
+        return false;
+    }
+    path_ = socketPath;
+    workers_.reserve(threads_);
+    for (std::size_t i = 0; i < threads_; ++i) workers_.emplace_back([this] { serve(); });
+    return true;
+}
+
+void QueryService::stop() {
+    if (wakeFds_[1] >= 0 && !workers_.empty()) {
+        const char byte = 0;
+        // 管道中留下的一个字节让所有 poll 都返回 / Оставленный в канале байт будит все poll
+        while (::write(wakeFds_[1], &byte, 1) < 0 && errno == EINTR) {}
+    }
+    for (auto& worker : workers_) worker.join();
+    workers_.clear();
+    for (int* fd : {&listenFd_, &wakeFds_[0], &wakeFds_[1]}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+    if (!path_.empty()) ::unlink(path_.c_str());
+    path_.clear();
+}
+
+void QueryService::serve() {
+    constexpr std::size_t kMaxRequest = 4096;
+    struct Connection {
+        int fd;
+        std::string pending;        ///< 未完整的请求行 / Неполная строка запроса
+    };
+    std::vector<Connection> connections;
+    std::vector<pollfd> polls;
+    io::OutputSink reply(nullptr, kMaxRequest);
+    char chunk[kMaxRequest];
+
+    for (;;) {
+        polls.clear();
+        polls.push_back({wakeFds_[0], POLLIN, 0});
+        polls.push_back({listenFd_, POLLIN, 0});
+        for (const auto& connection : connections) polls.push_back({connection.fd, POLLIN, 0});
+        if (::poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (polls[0].revents != 0) break;
+        if (polls[1].revents & POLLIN) {
+            // 其他线程可能先接受了连接，此时 accept 返回 EAGAIN
+            // Соединение мог принять другой поток, тогда accept вернёт EAGAIN
+            const int fd = ::accept(listenFd_, nullptr, nullptr);
+            if (fd >= 0) {
+                ::fcntl(fd, F_SETFL, 0);    // 有的系统会继承 O_NONBLOCK / Некоторые системы наследуют O_NONBLOCK
+                connections.push_back({fd, {}});
+            }
+        }
+        // 新接受的连接不在本轮 polls 中 / Только что принятого соединения нет в этом раунде polls
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < connections.size(); ++i) {
+            auto& connection = connections[i];
+            bool open = true;
+            if (i + 2 < polls.size() && polls[i + 2].revents != 0) {
+                const auto got = ::read(connection.fd, chunk, sizeof(chunk));
+                open = got > 0 || (got < 0 && errno == EINTR);
+                if (got > 0) connection.pending.append(chunk, static_cast<std::size_t>(got));
+                std::size_t begin = 0;
+                for (std::size_t end; (end = connection.pending.find('\n', begin)) != std::string::npos; begin = end + 1) {
+                    std::string_view request(connection.pending.data() + begin, end - begin);
+                    if (!request.empty() && request.back() == '\r') request.remove_suffix(1);
+                    answer(request, reply);
+                }
+                connection.pending.erase(0, begin);
+                if (connection.pending.size() > kMaxRequest) open = false;
+                const auto view = reply.view();
+                for (std::size_t sent = 0; open && sent < view.size();) {
+                    const auto wrote = ::send(connection.fd, view.data() + sent, view.size() - sent, MSG_NOSIGNAL);
+                    if (wrote < 0 && errno == EINTR) continue;
+                    if (wrote <= 0) open = false;
+                    else sent += static_cast<std::size_t>(wrote);
+                }
+                reply.clear();
+            }
+            if (open) {
+                if (kept != i) connections[kept] = std::move(connection);
+                ++kept;
+            } else {
+                ::close(connection.fd);
+            }
+        }
+        connections.resize(kept);
+    }
+    for (const auto& connection : connections) ::close(connection.fd);
+}
+
+#else
+
+bool QueryService::start(const std::string& socketPath) {
+    std::fprintf(stderr, "Query service is not supported on this platform: %s\n", socketPath.c_str());
+    return false;
+}
+
+void QueryService::stop() {}
+
+void QueryService::serve() {}
+
+#endif
+
+}  // namespace bank
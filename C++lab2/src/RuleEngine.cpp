@@ -0,0 +1,160 @@
+#include "RuleEngine.hpp"
+
+#include "Input.hpp"
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace bank {
+
+namespace {
+std::string_view trimRight(std::string_view text) {
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+bool parseKind(std::string_view name, RuleKind& kind) {
+    for (const auto candidate : {RuleKind::Velocity, RuleKind::LargeTransfer, RuleKind::AccountsOpened}) {
+        if (name == toString(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "<次数> # <分钟>"，次数 1..kMaxLimit，分钟 > 0 / "<число> # <минуты>", число 1..kMaxLimit, минуты > 0
+bool readCounter(io::FieldReader& fields, std::uint32_t& limit, std::uint32_t& window) {
+    unsigned long long count{};
+    unsigned long long minutes{};
+    if (!fields.readUnsigned(count) || !fields.separator() || !fields.readUnsigned(minutes)) return false;
+    if (count == 0 || count > RuleEngine::kMaxLimit || minutes == 0 || minutes > 0xffffffffULL) return false;
+    limit = static_cast<std::uint32_t>(count);
+    window = static_cast<std::uint32_t>(minutes);
+    return true;
+}
+}  // namespace
+
+const char* toString(RuleKind kind) {
+    switch (kind) {
+        case RuleKind::Velocity: return "Velocity";
+        case RuleKind::LargeTransfer: return "Large Transfer";
+        case RuleKind::AccountsOpened: return "Accounts Opened";
+    }
+    return "Unknown";
+}
+
+bool RuleEngine::load(const std::string& path) {
+    std::string text;
+    if (!readWholeFile(path, text)) {
+        std::fprintf(stderr, "Failed to read rules %s\n", path.c_str());
+        return false;
+    }
+    return parse(text);
+}
+
+bool RuleEngine::parse(std::string_view text) {
+    postingPlan_.clear();
+    openingPlan_.clear();
+    stride_ = 0;
+    clientBase_ = {};
+    slots_.clear();
+
+    io::LineCursor cursor(text);
+    std::string_view line;
+    std::uint32_t number = 0;
+    while (cursor.nextNonBlank(line)) {
+        ++number;
+        io::FieldReader fields(line);
+        std::string_view name;
+        Step step{};
+        step.rule = number;
+        bool valid = fields.readText(name) && parseKind(trimRight(name), step.kind) && fields.separator();
+        if (valid && step.kind == RuleKind::LargeTransfer) {
+            unsigned long long major{};
+            unsigned long long minor{};
+            std::string_view currency;
+            valid = fields.readUnsigned(major) && (!fields.literal('.') || fields.readUnsigned(minor)) &&
+                    fields.separator() && fields.readText(currency);
+            step.threshold = domain::parseMoneyParts(major, minor).thousandths;
+            step.currency = static_cast<std::int8_t>(domain::currencyIndex(domain::parseCurrency(trimRight(currency))));
+            valid = valid && step.currency >= 0;
+        } else if (valid) {
+            valid = readCounter(fields, step.limit, step.window);
+            // 客户状态：[头, limit 个时间戳] / Состояние клиента: [голова, limit меток]
+            step.offset = stride_;
+            stride_ += valid ? 1 + step.limit : 0;
+        }
+        if (!valid) {
+            std::fprintf(stderr, "Invalid rule %u: %.*s\n", number, static_cast<int>(line.size()), line.data());
+            return false;
+        }
+        (step.kind == RuleKind::AccountsOpened ? openingPlan_ : postingPlan_).push_back(step);
+    }
+    alerts_.clear();
+    alerts_.reserve(std::max(postingPlan_.size(), openingPlan_.size()));
+    return true;
+}
+
+std::uint32_t RuleEngine::clientState(unsigned long long clientId) {
+    if (const auto* base = clientBase_.find(clientId)) return *base;
+    const auto base = static_cast<std::uint32_t>(slots_.size());
+    slots_.resize(slots_.size() + stride_, kEmpty);
+    for (const auto* plan : {&postingPlan_, &openingPlan_}) {
+        for (const auto& step : *plan) {
+            if (step.limit != 0) slots_[base + step.offset] = 0;
+        }
+    }
+    clientBase_.emplace(clientId, base);
+    return base;
+}
+
+bool RuleEngine::exceeds(const Step& step, std::uint32_t base, std::uint32_t minute) {
+    // 环中最旧的是 limit 个事件之前的那个：它仍在窗口内，则窗口内共有 limit + 1 个
+    // Самое старое в кольце - событие limit событий назад: если оно ещё в окне, в окне limit + 1 событий
+    auto& head = slots_[base + step.offset];
+    auto& oldest = slots_[base + step.offset + 1 + head];
+    const bool hit = oldest != kEmpty && minute - oldest < step.window;
+    oldest = minute;
+    head = head + 1 == step.limit ? 0 : head + 1;
+    return hit;
+}
+
+void RuleEngine::run(const std::vector<Step>& plan, std::uint32_t minute, unsigned long long clientId,
+                     unsigned long long accountId, std::int8_t currency, domain::Money amount) {
+    alerts_.clear();
+    if (plan.empty()) return;
+    const auto base = stride_ == 0 ? 0 : clientState(clientId);
+    for (const auto& step : plan) {
+        bool hit = false;
+        switch (step.kind) {
+            case RuleKind::LargeTransfer:
+                hit = step.currency == currency && amount.thousandths >= step.threshold;
+                break;
+            case RuleKind::Velocity:
+            case RuleKind::AccountsOpened:
+                hit = exceeds(step, base, minute);
+                break;
+        }
+        if (hit) alerts_.push_back({step.rule, step.kind, clientId, accountId, amount});
+    }
+}
+
+std::span<const RuleAlert> RuleEngine::onPosting(const domain::DateTime& time,
+                                                 unsigned long long clientId,
+                                                 unsigned long long accountId,
+                                                 domain::Currency currency,
+                                                 domain::Money amount) {
+    run(postingPlan_, toMinute(time), clientId, accountId, static_cast<std::int8_t>(domain::currencyIndex(currency)), amount);
+    return alerts_;
+}
+
+std::span<const RuleAlert> RuleEngine::onAccountOpened(const domain::DateTime& time,
+                                                       unsigned long long clientId,
+                                                       unsigned long long accountId) {
+    run(openingPlan_, toMinute(time), clientId, accountId, -1, domain::Money{});
+    return alerts_;
+}
+
+}  // namespace bank
@@ -0,0 +1,157 @@
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace bank {
+
+unsigned long long waitPercentile(const std::vector<unsigned long long>& histogram, double q) {
+    unsigned long long total = 0;
+    for (auto count : histogram) total += count;
+    if (total == 0) return 0;
+    const auto rank = std::max<unsigned long long>(1, static_cast<unsigned long long>(std::ceil(q * static_cast<double>(total))));
+    unsigned long long seen = 0;
+    for (std::size_t minutes = 0; minutes < histogram.size(); ++minutes) {
+        seen += histogram[minutes];
+        if (seen >= rank) return minutes;
+    }
+    return histogram.size() - 1;
+}
+
+void WorkplaceScheduler::configure(const std::vector<domain::WorkplaceDefinition>& workplaces) {
+    counts_ = {};
+    for (const auto& def : workplaces) {
+        if (def.type == domain::WorkplaceKind::Unknown) continue;
+        counts_[static_cast<std::size_t>(def.type)] += static_cast<std::uint32_t>(def.count);
+    }
+}
+
+void WorkplaceScheduler::startDay() {
+    customers_.clear();
+    stages_.clear();
+}
+
+domain::WorkplaceKind WorkplaceScheduler::resolve(domain::WorkplaceKind kind) const {
+    if (kind == domain::WorkplaceKind::Unknown) return kind;
+    if (counts_[static_cast<std::size_t>(kind)] > 0) return kind;
+    // 分行没有优先客户经理时由普通窗口接待 / Без VIP-менеджеров VIP-клиентов принимает обычное окно
+    if (kind == domain::WorkplaceKind::VipManager && counts_[static_cast<std::size_t>(domain::WorkplaceKind::ClientManager)] > 0) {
+        return domain::WorkplaceKind::ClientManager;
+    }
+    return domain::WorkplaceKind::Unknown;
+}
+
+void WorkplaceScheduler::addCustomer(std::uint32_t arrivalMinute, bool vip) {
+    customers_.push_back({arrivalMinute, static_cast<std::uint32_t>(stages_.size()), 0, 0, 0, 0, vip});
+}
+
+void WorkplaceScheduler::addService(domain::WorkplaceKind kind, std::uint32_t minutes) {
+    kind = resolve(kind);
+    if (kind == domain::WorkplaceKind::Unknown || minutes == 0 || customers_.empty()) return;
+    auto& customer = customers_.back();
+    // 同一岗位能办的业务一次办完 / Всё, что делается у одного места, - за один подход
+    for (std::uint32_t i = 0; i < customer.stageCount; ++i) {
+        auto& stage = stages_[customer.firstStage + i];
+        if (stage.kind == kind) {
+            stage.minutes += minutes;
+            return;
+        }
+    }
+    stages_.push_back({kind, minutes});
+    ++customer.stageCount;
+}
+
+void WorkplaceScheduler::push(Event event) {
+    event.seq = seq_++;
+    timeline_.push_back(event);
+    std::push_heap(timeline_.begin(), timeline_.end(), EventLater{});
+}
+
+void WorkplaceScheduler::arrive(std::uint32_t now, std::uint32_t customer) {
+    auto& c = customers_[customer];
+    const auto kind = stages_[c.firstStage + c.nextStage].kind;
+    auto& line = lines_[static_cast<std::size_t>(kind)];
+    c.enqueuedAt = now;
+    (c.vip ? line.vip : line.regular).push_back(customer);
+    dispatch(now, kind);
+}
+
+void WorkplaceScheduler::dispatch(std::uint32_t now, domain::WorkplaceKind kind) {
+    if (now >= kCloseMinute) return;
+    auto& line = lines_[static_cast<std::size_t>(kind)];
+    while (!line.freeInstances.empty()) {
+        std::uint32_t customer{};
+        if (line.vipHead < line.vip.size()) {
+            customer = line.vip[line.vipHead++];
+        } else if (line.regularHead < line.regular.size()) {
+            customer = line.regular[line.regularHead++];
+        } else {
+            return;
+        }
+        std::pop_heap(line.freeInstances.begin(), line.freeInstances.end(), std::greater<>{});
+        const auto instance = line.freeInstances.back();
+        line.freeInstances.pop_back();
+
+        auto& c = customers_[customer];
+        c.waited += now - c.enqueuedAt;
+        ++report_.served[static_cast<std::size_t>(kind)][instance];
+        const auto minutes = stages_[c.firstStage + c.nextStage].minutes;
+        push({now + minutes, EventType::Completion, 0, customer, instance, kind});
+    }
+}
+
+QueueReport WorkplaceScheduler::finishDay() {
+    report_ = QueueReport{};
+    for (std::size_t k = 0; k < domain::kWorkplaceKindCount; ++k) {
+        report_.served[k].assign(counts_[k], 0);
+        auto& line = lines_[k];
+        line.vip.clear();
+        line.regular.clear();
+        line.vipHead = 0;
+        line.regularHead = 0;
+        // 升序数组即合法的最小堆 / Массив по возрастанию - корректная мин-куча
+        line.freeInstances.resize(counts_[k]);
+        for (std::uint32_t i = 0; i < counts_[k]; ++i) line.freeInstances[i] = i;
+    }
+    timeline_.clear();
+    timeline_.reserve(stages_.size() * 2);
+    seq_ = 0;
+
+    for (std::uint32_t i = 0; i < customers_.size(); ++i) {
+        if (customers_[i].stageCount == 0) continue;
+        ++report_.customers;
+        push({std::max(customers_[i].arrival, kOpenMinute), EventType::Arrival, 0, i, 0, domain::WorkplaceKind::Unknown});
+    }
+
+    unsigned long long finished = 0;
+    while (!timeline_.empty()) {
+        std::pop_heap(timeline_.begin(), timeline_.end(), EventLater{});
+        const Event event = timeline_.back();
+        timeline_.pop_back();
+
+        if (event.type == EventType::Arrival) {
+            // 营业结束后取号的客户不再受理 / После закрытия новые номера не обслуживаются
+            if (event.time < kCloseMinute) arrive(event.time, event.customer);
+            continue;
+        }
+
+        auto& line = lines_[static_cast<std::size_t>(event.kind)];
+        line.freeInstances.push_back(event.instance);
+        std::push_heap(line.freeInstances.begin(), line.freeInstances.end(), std::greater<>{});
+
+        auto& c = customers_[event.customer];
+        if (++c.nextStage < c.stageCount) {
+            push({event.time, EventType::Arrival, 0, event.customer, 0, domain::WorkplaceKind::Unknown});
+        } else {
+            ++finished;
+            if (report_.waitHistogram.size() <= c.waited) report_.waitHistogram.resize(c.waited + 1, 0);
+            ++report_.waitHistogram[c.waited];
+        }
+        dispatch(event.time, event.kind);
+    }
+    report_.turnedAway = report_.customers - finished;
+    return report_;
+}
+
+}  // namespace bank
@@ -0,0 +1,107 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace {
+// 当前线程所属的线程池与队列编号 / Пул и номер очереди текущего потока
+thread_local const bank::ThreadPool* tlsPool = nullptr;
+thread_local std::size_t tlsQueue = 0;
+}  // namespace
+
+namespace bank {
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    queues_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<WorkQueue>());
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t target = tlsPool == this ? tlsQueue : nextQueue_.fetch_add(1) % queues_.size();
+    // 先计数再入队：任务在计数之前被取走并完成会使 pending_ 下溢。
+    // Сначала счётчики, потом очередь: иначе задача, выполненная до подсчёта, обнулила бы pending_ раньше времени.
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        ++queued_;
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool ThreadPool::tryTake(std::size_t self, Task& task) {
+    // 先取自己队列的尾部 / Сначала хвост своей очереди
+    {
+        auto& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    // 再从其他队列头部窃取 / Затем голова чужих очередей
+    for (std::size_t step = 1; step < queues_.size(); ++step) {
+        auto& victim = *queues_[(self + step) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    tlsPool = this;
+    tlsQueue = self;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0) return;
+        }
+        Task task;
+        // 计数已增加但任务尚未入队，或已被其他线程取走 / Задача ещё не в очереди или уже забрана
+        if (!tryTake(self, task)) {
+            std::this_thread::yield();
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            --queued_;
+        }
+        task();
+        bool done = false;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            done = --pending_ == 0;
+        }
+        if (done) idle_.notify_all();
+    }
+}
+
+}  // namespace bank
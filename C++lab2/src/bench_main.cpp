@@ -0,0 +1,230 @@
+/**
+ * @file bench_main.cpp
+ * @brief bank_sim 基准测试 / Бенчмарк bank_sim
+ *
+ * 用法：bank_bench [--sim bank_sim路径] [-c 客户数] [-d 营业日数] [-a 每日到访数] [-r 重复次数]
+ *                 [--shards N] [--keep 目录]
+ *
+ * 先用生成器写出混合操作的输入，运行 bank_sim 并报告每秒事件数、每秒操作数与峰值常驻内存；
+ * 再为每种操作单独生成只含该操作的输入，与不含操作的基线输入（到访数相同）对比，
+ * 两者运行时间之差除以操作数即该类型每次操作的纳秒数。每个输入运行 r 次取最短时间。
+ *
+ * Использование: bank_bench [--sim путь_к_bank_sim] [-c клиентов] [-d дней] [-a обращений в день]
+ *                           [-r повторов] [--shards N] [--keep каталог]
+ *
+ * Сначала генерируется ввод со смешанными операциями, bank_sim запускается на нём,
+ * выводятся события в секунду, операции в секунду и пиковый резидентный объём памяти.
+ * Затем для каждого типа операции генерируется ввод только с этой операцией и
+ * сравнивается с базовым вводом без операций (с тем же числом обращений): разность
+ * времени, делённая на число операций, - наносекунды на операцию этого типа.
+ * Каждый ввод запускается r раз, берётся минимальное время.
+ */
+
+#include "Generator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+#ifndef BANK_SIM_PATH
+#define BANK_SIM_PATH "bank_sim"
+#endif
+
+namespace {
+
+struct RunResult {
+    bool ok{false};          ///< 进程能否启动且正常结束 / Процесс запустился и завершился с кодом 0
+    double seconds{0.0};     ///< 墙钟时间 / Время по часам
+    long peakRssKb{0};       ///< 峰值常驻内存 / Пиковый резидентный объём
+};
+
+#if !defined(_WIN32)
+RunResult runOnce(const std::string& sim, const std::vector<std::string>& args, const std::string& outputBase) {
+    RunResult result;
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(sim.c_str()));
+    for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    // 响应与日志写入文件，以免终端输出计入耗时 / Ответы и журнал - в файлы, чтобы вывод на терминал не влиял на время
+    const std::string outPath = outputBase + ".out";
+    const std::string logPath = outputBase + ".log";
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    const auto start = std::chrono::steady_clock::now();
+    pid_t pid{};
+    const int spawned = posix_spawn(&pid, sim.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (spawned != 0) {
+        std::fprintf(stderr, "Failed to start %s: %s\n", sim.c_str(), std::strerror(spawned));
+        return result;
+    }
+    int status = 0;
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) != pid) return result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.peakRssKb = usage.ru_maxrss;
+    result.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return result;
+}
+#else
+RunResult runOnce(const std::string&, const std::vector<std::string>&, const std::string&) {
+    std::fprintf(stderr, "bank_bench is only supported on POSIX systems\n");
+    return {};
+}
+#endif
+
+bool writeInput(const std::filesystem::path& path, const std::string& text) {
+    std::FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    std::fclose(file);
+    return written;
+}
+
+struct Bench {
+    std::string sim;
+    std::filesystem::path directory;
+    std::vector<std::string> extraArgs;
+    std::size_t repeats{3};
+
+    // 多次运行取最短时间与最大内存 / Несколько запусков: минимальное время и максимальная память
+    RunResult measure(const std::string& name, const std::string& text) const {
+        const auto input = directory / (name + ".txt");
+        if (!writeInput(input, text)) {
+            std::fprintf(stderr, "Failed to write %s\n", input.string().c_str());
+            return {};
+        }
+        auto args = extraArgs;
+        args.push_back(input.string());
+        RunResult best;
+        for (std::size_t i = 0; i < repeats; ++i) {
+            const auto run = runOnce(sim, args, (directory / name).string());
+            if (!run.ok) {
+                std::fprintf(stderr, "%s failed on %s (see %s.log)\n", sim.c_str(), input.string().c_str(),
+                             (directory / name).string().c_str());
+                return run;
+            }
+            best.seconds = best.ok ? std::min(best.seconds, run.seconds) : run.seconds;
+            best.peakRssKb = std::max(best.peakRssKb, run.peakRssKb);
+            best.ok = true;
+        }
+        return best;
+    }
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--sim path] [-c clients] [-d days] [-a appeals_per_day] [-r repeats]\n"
+                 "          [--shards N] [--keep dir]\n",
+                 program);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bank::GeneratorConfig config;
+    config.clients = 20000;
+    config.days = 20;
+    config.appealsPerDay = 2000;
+
+    Bench bench;
+    bench.sim = BANK_SIM_PATH;
+    const char* keepDir = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sim") == 0 && hasValue) {
+            bench.sim = argv[++i];
+        } else if (std::strcmp(argv[i], "-c") == 0 && hasValue) {
+            config.clients = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-d") == 0 && hasValue) {
+            config.days = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-a") == 0 && hasValue) {
+            config.appealsPerDay = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-r") == 0 && hasValue) {
+            bench.repeats = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--shards") == 0 && hasValue) {
+            bench.extraArgs = {"--shards", argv[++i]};
+        } else if (std::strcmp(argv[i], "--keep") == 0 && hasValue) {
+            keepDir = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::error_code ec;
+    const auto stamp = std::chrono::system_clock::now().time_since_epoch().count();
+    bench.directory = keepDir ? std::filesystem::path(keepDir)
+                              : std::filesystem::temp_directory_path(ec) / ("bank_bench_" + std::to_string(stamp));
+    std::filesystem::create_directories(bench.directory, ec);
+    if (ec) {
+        std::fprintf(stderr, "Failed to create %s\n", bench.directory.string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::printf("bank_sim: %s\n", bench.sim.c_str());
+    std::printf("clients %zu, days %zu, appeals/day %zu, best of %zu runs\n\n", config.clients, config.days,
+                config.appealsPerDay, bench.repeats);
+
+    // 混合负载 / Смешанная нагрузка
+    const auto mixed = bank::generateBranchInput(config);
+    const auto mixedRun = bench.measure("mixed", mixed.text);
+    bool ok = mixedRun.ok;
+    if (mixedRun.ok) {
+        std::size_t operations = 0;
+        for (auto count : mixed.operations) operations += count;
+        std::printf("mixed: %zu events, %zu operations, %.1f MiB input\n", mixed.events, operations,
+                    static_cast<double>(mixed.text.size()) / (1024.0 * 1024.0));
+        std::printf("  wall %.3f s, %.0f events/s, %.0f operations/s, peak RSS %.1f MiB\n\n", mixedRun.seconds,
+                    static_cast<double>(mixed.events) / mixedRun.seconds,
+                    static_cast<double>(operations) / mixedRun.seconds,
+                    static_cast<double>(mixedRun.peakRssKb) / 1024.0);
+    }
+
+    // 基线：到访数相同但没有操作 / База: те же обращения без операций
+    auto baselineConfig = config;
+    baselineConfig.maxOperations = 0;
+    const auto baseline = bench.measure("baseline", bank::generateBranchInput(baselineConfig).text);
+    ok = ok && baseline.ok;
+
+    std::printf("%-20s %12s %12s %12s\n", "operation", "count", "ns/op", "peak MiB");
+    for (std::size_t index = 0; baseline.ok && index < domain::kOperationCount; ++index) {
+        if (config.mix[index] == 0) continue;
+        const auto op = static_cast<domain::Operation>(index);
+        auto single = config;
+        single.mix = {};
+        single.mix[index] = 1;
+        const auto input = bank::generateBranchInput(single);
+        const auto run = bench.measure(bank::operationKey(op), input.text);
+        if (!run.ok) {
+            ok = false;
+            continue;
+        }
+        const auto count = input.operations[index];
+        const double ns = count == 0 ? 0.0 : (run.seconds - baseline.seconds) * 1e9 / static_cast<double>(count);
+        std::printf("%-20s %12zu %12.0f %12.1f\n", domain::toString(op), count, std::max(ns, 0.0),
+                    static_cast<double>(run.peakRssKb) / 1024.0);
+    }
+
+    if (!keepDir) std::filesystem::remove_all(bench.directory, ec);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
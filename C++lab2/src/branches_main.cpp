@@ -0,0 +1,71 @@
+/**
+ * @file branches_main.cpp
+ * @brief 多分行模拟入口 / Точка входа многофилиальной симуляции
+ *
+ * 用法：bank_branches [-j 线程数] [-o 输出目录] 输入文件...
+ * 每个输入文件是一个分行；响应写入 <输出目录>/<文件名>.out，日志写入 .log，
+ * 按营业日汇总的日报写到 stdout。
+ *
+ * Использование: bank_branches [-j потоков] [-o каталог] входные_файлы...
+ * Каждый входной файл - отделение; ответы пишутся в <каталог>/<имя>.out,
+ * журнал - в .log, сводный отчёт по банковским дням - в stdout.
+ */
+
+#include "BranchDriver.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+void printUsage(const char* program) {
+    std::fprintf(stderr, "Usage: %s [-j threads] [-o output_dir] input...\n", program);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t threads = 0;
+    std::filesystem::path outputDir;
+    std::vector<bank::BranchJob> jobs;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            const std::filesystem::path input(argv[i]);
+            // 默认输出放在输入文件旁边 / По умолчанию вывод рядом с входным файлом
+            const auto base = outputDir.empty() ? input : outputDir / input.filename();
+            jobs.push_back({input.string(), base.string() + ".out", base.string() + ".log"});
+        }
+    }
+    if (jobs.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const auto results = bank::runBranches(jobs, threads);
+        bool ok = true;
+        for (const auto& result : results) {
+            if (!result.loaded || !result.completed) {
+                std::fprintf(stderr, "Branch %s did not complete\n", result.inputPath.c_str());
+                ok = false;
+            }
+        }
+        io::OutputSink out(stdout);
+        bank::writeDaySummary(out, bank::summarizeDays(results));
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "Unhandled exception: %s\n", ex.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file gen_main.cpp
+ * @brief 分行输入生成器入口 / Точка входа генератора входных файлов
+ *
+ * 用法：bank_gen [-c 客户数] [-d 营业日数] [-a 每日到访数] [-k 每次最多操作数]
+ *              [--new 新客户比例] [--mix 权重] [--seed 种子] [-o 输出文件]
+ * 不指定 -o 时写到 stdout。
+ *
+ * Использование: bank_gen [-c клиентов] [-d дней] [-a обращений в день] [-k операций на обращение]
+ *                         [--new доля новых клиентов] [--mix веса] [--seed зерно] [-o файл]
+ * Без -o результат пишется в stdout.
+ */
+
+#include "Generator.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [-c clients] [-d days] [-a appeals_per_day] [-k max_operations] [--new share]\n"
+                 "          [--mix balance=6,create=1,close=1,withdraw=3,topup=3,exchange=2,card=1]\n"
+                 "          [--seed N] [-o output]\n",
+                 program);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bank::GeneratorConfig config;
+    const char* outputPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-c") == 0 && hasValue) {
+            config.clients = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-d") == 0 && hasValue) {
+            config.days = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-a") == 0 && hasValue) {
+            config.appealsPerDay = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "-k") == 0 && hasValue) {
+            config.maxOperations = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--new") == 0 && hasValue) {
+            config.newClientShare = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--mix") == 0 && hasValue) {
+            if (!bank::parseOperationMix(argv[++i], config.mix)) {
+                std::fprintf(stderr, "Invalid operation mix %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (std::strcmp(argv[i], "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto input = bank::generateBranchInput(config);
+    std::FILE* out = outputPath ? std::fopen(outputPath, "wb") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Failed to open output %s\n", outputPath);
+        return EXIT_FAILURE;
+    }
+    const bool written = std::fwrite(input.text.data(), 1, input.text.size(), out) == input.text.size();
+    if (out != stdout) std::fclose(out);
+    if (!written) {
+        std::fprintf(stderr, "Failed to write output\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
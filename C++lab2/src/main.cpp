@@ -11,31 +11,183 @@
  */
 
 #include "Bank.hpp"
+#include "QueryService.hpp"
 
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <iostream>
+#include <memory>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <pthread.h>
+#endif
+
+namespace {
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--shards N] [--window N] [--journal DIR] [--snapshot-every N] [--ledger FILE]\n"
+                 "          [--export FILE] [--serve SOCKET] [--query-threads N] [--history]\n"
+                 "          [--rules FILE --alerts FILE] [--profile FILE] [input]\n",
+                 program);
+}
+}  // namespace
 
 /**
  * @brief 主函数 / Главная функция
  * 
  * 程序执行流程：
  * 1. 创建 BankSystem 实例
- * 2. 调用 loadInitialData() 读取所有初始数据
- * 3. 调用 run() 进入事件循环，处理所有事件直到输入结束
+ * 2. 调用 loadInitialData() 读取所有初始数据（可选参数为输入文件路径，缺省为 stdin；
+ *    "--shards N" 在 N 个线程上推测执行 Personal Appeal，"--window N" 为每个推测窗口的来访数；
+ *    "--journal DIR" 写预写日志与快照，重启时从最后提交的营业日继续，"--snapshot-every N" 为快照间隔；
+ *    "--ledger FILE" 把过账分录以二进制记录追加到 FILE；"--export FILE" 每个营业日结束时把账户表列式追加到 FILE；
+ *    "--serve SOCKET" 在 Unix 域套接字上提供只读查询，"--query-threads N" 为读线程数；
+ *    "--history" 记录余额版本，重放结束后可按任意时刻查询余额；
+ *    "--rules FILE" 在过账流上检查风控规则，触发写入 "--alerts FILE"；
+ *    "--profile FILE" 在 BANK_PROFILE 构建中把每日各操作的延迟统计写入 FILE）
+ * 3. 调用 run() 进入事件循环，处理所有事件直到输入结束；
+ *    查询模式下随后继续按最终状态回答查询，直到收到 SIGINT/SIGTERM
  * 
  * Порядок выполнения программы:
  * 1. Создание экземпляра BankSystem
- * 2. Вызов loadInitialData() для чтения всех начальных данных
- * 3. Вызов run() для входа в цикл обработки событий до конца ввода
+ * 2. Вызов loadInitialData() для чтения всех начальных данных (необязательный аргумент - путь к файлу, по умолчанию stdin;
+ *    "--shards N" - спекулятивное выполнение Personal Appeal на N потоках, "--window N" - обращений в окне спекуляции;
+ *    "--journal DIR" - журнал и снимки, перезапуск продолжает с последнего зафиксированного дня,
+ *    "--snapshot-every N" - интервал снимков в днях; "--ledger FILE" - дозапись проводок двоичными записями в FILE;
+ *    "--export FILE" - колоночная выгрузка таблицы счетов в FILE в конце каждого дня;
+ *    "--serve SOCKET" - запросы только для чтения на Unix-сокете, "--query-threads N" - число потоков чтения;
+ *    "--history" - версии остатков, после воспроизведения остаток запрашивается на любой момент;
+ *    "--rules FILE" - правила контроля мошенничества на потоке проводок, срабатывания в "--alerts FILE";
+ *    "--profile FILE" - в сборке с BANK_PROFILE ежедневная статистика задержек операций в FILE)
+ * 3. Вызов run() для входа в цикл обработки событий до конца ввода;
+ *    в режиме запросов затем ответы по итоговому состоянию продолжаются до SIGINT/SIGTERM
  * 
  * @return EXIT_SUCCESS 成功 / при успехе, EXIT_FAILURE 失败 / при ошибке
  */
-int main() {
+int main(int argc, char* argv[]) {
+    const char* inputPath = nullptr;
+    std::size_t shards = 1;
+    std::size_t window = 256;
+    const char* journalDir = nullptr;
+    unsigned long long snapshotEvery = 10;
+    const char* ledgerPath = nullptr;
+    const char* exportPath = nullptr;
+    const char* socketPath = nullptr;
+    std::size_t queryThreads = 0;
+    bool history = false;
+    const char* rulesPath = nullptr;
+    const char* alertsPath = nullptr;
+    const char* profilePath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            shards = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journalDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--snapshot-every") == 0 && i + 1 < argc) {
+            snapshotEvery = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--ledger") == 0 && i + 1 < argc) {
+            ledgerPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+            exportPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--query-threads") == 0 && i + 1 < argc) {
+            queryThreads = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--history") == 0) {
+            history = true;
+        } else if (std::strcmp(argv[i], "--rules") == 0 && i + 1 < argc) {
+            rulesPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--alerts") == 0 && i + 1 < argc) {
+            alertsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (argv[i][0] == '-') {
+            // 未知选项或缺少参数值的选项 / Неизвестный ключ или ключ без значения
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            inputPath = argv[i];
+        }
+    }
+
+    // 告警与统计文件比 BankSystem 活得久，析构时最后一次刷新仍能写入
+    // Файлы срабатываний и статистики живут дольше BankSystem, чтобы последний сброс в деструкторе дошёл до них
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> alerts(nullptr, std::fclose);
+    if (rulesPath) {
+        if (!alertsPath) {
+            std::fprintf(stderr, "--rules requires --alerts FILE\n");
+            return EXIT_FAILURE;
+        }
+        alerts.reset(std::fopen(alertsPath, "w"));
+        if (!alerts) {
+            std::fprintf(stderr, "Failed to open alerts %s\n", alertsPath);
+            return EXIT_FAILURE;
+        }
+    }
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> profile(nullptr, std::fclose);
+    if (profilePath) {
+#if !BANK_PROFILE
+        std::fprintf(stderr, "--profile requires a build configured with -DBANK_PROFILE=ON\n");
+        return EXIT_FAILURE;
+#endif
+        profile.reset(std::fopen(profilePath, "w"));
+        if (!profile) {
+            std::fprintf(stderr, "Failed to open profile %s\n", profilePath);
+            return EXIT_FAILURE;
+        }
+    }
+
+#if !defined(_WIN32)
+    // 在创建任何线程之前屏蔽，之后由主线程 sigwait 等待停止信号
+    // Блокировка до создания потоков; затем главный поток ждёт сигнал остановки через sigwait
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    if (socketPath) pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+#endif
+
     try {
+        bank::QueryService queryService(queryThreads);
         bank::BankSystem bankSystem;        // 创建银行系统实例 / Создание экземпляра банковской системы
-        bankSystem.loadInitialData();       // 加载初始数据 / Загрузка начальных данных
-        bankSystem.run();                    // 运行事件循环 / Запуск цикла обработки событий
+        bankSystem.setAppealShards(shards);
+        bankSystem.setSpeculationWindow(window);
+        if (!bankSystem.loadInitialData(inputPath)) {  // 加载初始数据 / Загрузка начальных данных
+            return EXIT_FAILURE;
+        }
+        if (ledgerPath && !bankSystem.enableLedger(ledgerPath)) {
+            return EXIT_FAILURE;
+        }
+        if (exportPath && !bankSystem.enableColumnarExport(exportPath)) {
+            return EXIT_FAILURE;
+        }
+        if (journalDir && !bankSystem.enableJournal(journalDir, snapshotEvery)) {
+            return EXIT_FAILURE;
+        }
+        if (history) bankSystem.enableBalanceHistory();
+        if (rulesPath && !bankSystem.enableRules(rulesPath, alerts.get())) {
+            return EXIT_FAILURE;
+        }
+        if (profile) bankSystem.enableProfileReport(profile.get());
+        if (socketPath) {
+            if (!queryService.start(socketPath)) return EXIT_FAILURE;
+            bankSystem.attachQueryService(&queryService);
+        }
+        const bool completed = bankSystem.run();   // 运行事件循环；银行违约时失败退出 / Цикл событий; при дефолте банка - ошибка
+#if !defined(_WIN32)
+        if (socketPath) {
+            int received = 0;
+            sigwait(&stopSignals, &received);
+        }
+#endif
+        if (!completed) {
+            return EXIT_FAILURE;
+        }
     } catch (const std::exception &ex) {
         // 捕获所有标准异常并输出到 stderr / Перехват всех стандартных исключений и вывод в stderr
         std::fprintf(stderr, "Unhandled exception: %s\n", ex.what());
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file TestSupport.hpp
+ * @brief 测试共用的辅助函数 / Общие вспомогательные функции тестов
+ *
+ * 各测试都需要写输入文件、运行一个分行并取回响应与交易日志，这里只保留一份实现。
+ * Всем тестам нужно записать входной файл, запустить отделение и получить ответы и
+ * журнал транзакций; здесь единственная реализация этого.
+ */
+
+#include "Bank.hpp"
+#include "QueryService.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace test_support {
+
+/// 从头读出整个文件 / Чтение всего файла с начала
+inline std::string readAll(std::FILE* file) {
+    std::string text;
+    std::rewind(file);
+    char chunk[4096];
+    std::size_t got = 0;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, got);
+    return text;
+}
+
+/// 覆盖写入 path / Перезапись файла path
+inline void writeFile(const std::string& path, std::string_view text) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    assert(file);
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+}
+
+/// 直接向查询服务提一个请求，返回应答 / Прямой запрос к службе запросов, возвращает ответ
+inline std::string ask(const bank::QueryService& service, const char* request) {
+    io::OutputSink reply(nullptr, 256);
+    service.answer(request, reply);
+    return std::string(reply.view());
+}
+
+using BranchHook = std::function<void(bank::BankSystem&)>;
+
+/**
+ * @brief 运行一个分行，返回 (响应, 日志) / Запуск отделения, возвращает (ответы, журнал)
+ *
+ * setup 在 loadInitialData 之后、run 之前调用（开启日志、账簿等），inspect 在 run 之后调用。
+ * setup вызывается после loadInitialData и до run (включение журнала, книги и т.п.), inspect - после run.
+ */
+inline std::pair<std::string, std::string> simulate(const std::string& input,
+                                                    std::size_t shards = 1,
+                                                    std::size_t window = 256,
+                                                    const BranchHook& setup = {},
+                                                    const BranchHook& inspect = {}) {
+    std::FILE* out = std::tmpfile();
+    std::FILE* log = std::tmpfile();
+    assert(out && log);
+    {
+        bank::BankSystem branch(out, log);
+        branch.setAppealShards(shards);
+        branch.setSpeculationWindow(window);
+        const bool loaded = branch.loadInitialData(input.c_str());
+        assert(loaded);
+        (void)loaded;
+        if (setup) setup(branch);
+        branch.run();
+        if (inspect) inspect(branch);
+    }
+    auto result = std::make_pair(readAll(out), readAll(log));
+    std::fclose(out);
+    std::fclose(log);
+    return result;
+}
+
+}  // namespace test_support
@@ -0,0 +1,45 @@
+#include "Bank.hpp"
+#include "Generator.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+using test_support::simulate;
+
+// 推测执行的响应与交易日志必须与顺序执行逐字节一致，与线程数和窗口大小无关。
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const auto serial = simulate(argv[i], 1);
+        assert(!serial.first.empty());
+        for (std::size_t shards : {2, 3, 8}) {
+            const auto sharded = simulate(argv[i], shards);
+            assert(sharded.first == serial.first);
+            assert(sharded.second == serial.second);
+        }
+        for (std::size_t window : {1, 3, 0}) {
+            const auto windowed = simulate(argv[i], 3, window);
+            assert(windowed == serial);
+        }
+    }
+
+    // 客户少、来访多：同一窗口内同一客户的来访冲突，只有它们重新执行
+    // Мало клиентов, много обращений: обращения одного клиента в окне конфликтуют, и только они выполняются заново
+    bank::GeneratorConfig config;
+    config.clients = 40;
+    config.days = 3;
+    config.appealsPerDay = 300;
+    const char* generated = "appeal_shards_generated.txt";
+    test_support::writeFile(generated, bank::generateBranchInput(config).text);
+    const auto serial = simulate(generated, 1);
+    bank::BankSystem::SpeculationStats stats;
+    const auto speculated = simulate(generated, 4, 64, {}, [&stats](bank::BankSystem& branch) {
+        stats = branch.speculationStats();
+    });
+    assert(speculated == serial);
+    assert(stats.appeals > 0);
+    assert(stats.reexecuted > 0 && stats.reexecuted < stats.appeals);
+    std::remove(generated);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "BalanceHistory.hpp"
+#include "Bank.hpp"
+#include "QueryService.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 2\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 1\n"
+    "1002\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 1\n"
+    "Withdraw Funds # 1001 # 100.000\n"
+    "1 # 11:30 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 1\n"
+    "Top-up Founds # 1001 # 50.000\n"
+    "1 # 19:00 # End of Bank Day\n";
+
+domain::Money money(std::int64_t thousandths) { return domain::Money::fromThousandths(thousandths); }
+
+using test_support::ask;
+}  // namespace
+
+// 版本按分钟合并、跨块查询与重放后的按时刻查询。
+int main() {
+    bank::BalanceHistory history;
+    assert(!history.asOf(7, {1, 9, 0}));
+    // 同一分钟的多次变动只留最后一个余额 / Из нескольких изменений в одну минуту остаётся последний остаток
+    history.record(7, {1, 9, 0}, money(1000));
+    history.record(7, {1, 9, 0}, money(900));
+    for (std::int64_t i = 1; i <= 40; ++i) history.record(7, {1, 9, static_cast<unsigned long long>(i)}, money(900 - i * 10));
+    assert(history.versions() == 41);
+    assert(!history.asOf(7, {1, 8, 59}));
+    assert(*history.asOf(7, {1, 9, 0}) == money(900));
+    assert(*history.asOf(7, {1, 9, 15}) == money(750));
+    assert(*history.asOf(7, {1, 9, 16}) == money(740));         // 第二块的检查点 / Контрольная точка второго блока
+    assert(*history.asOf(7, {1, 9, 40}) == money(500));
+    assert(*history.asOf(7, {9, 0, 0}) == money(500));
+    // 时间倒退按上一版本的时间记录 / Время назад записывается временем предыдущей версии
+    history.record(7, {1, 9, 1}, money(-250));
+    assert(*history.asOf(7, {1, 9, 40}) == money(-250));
+    assert(history.bytes() < 41 * (sizeof(std::uint64_t) + sizeof(std::int64_t)));
+
+    const char* inputPath = "balance_history_input.txt";
+    test_support::writeFile(inputPath, kInput);
+
+    bank::QueryService service(1);
+    const auto setup = [&service](bank::BankSystem& branch) {
+        branch.attachQueryService(&service);
+        assert(!branch.balanceAsOf(1001, {1, 9, 0}));
+        branch.enableBalanceHistory();
+    };
+    test_support::simulate(inputPath, 1, 256, setup, [](bank::BankSystem& branch) {
+        assert(*branch.balanceAsOf(1001, {1, 8, 59}) == money(1000000));
+        assert(*branch.balanceAsOf(1001, {1, 9, 0}) == money(897500));
+        assert(*branch.balanceAsOf(1001, {1, 11, 29}) == money(897500));
+        assert(*branch.balanceAsOf(1001, {1, 11, 30}) == money(946500));
+        assert(*branch.balanceAsOf(1002, {1, 10, 0}) == money(500002500));
+        (void)branch;
+    });
+    std::remove(inputPath);
+
+    assert(ask(service, "Balance As Of # 1001 # 1 # 10:15") ==
+           "1 # 19:0 # Balance of 1001 as of 1 # 10:15 # 897.500 # USD\n");
+    assert(ask(service, "Balance As Of # 7 # 1 # 10:15") == "1 # 19:0 # Client error. Unknown account\n");
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "Bank.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 3\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "1003 # debit # 500000.000 # RUB\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 2\n"
+    "1002\n"
+    "1003\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 5\n"
+    "Create Account # USD\n"
+    "Close Account # 1001\n"
+    "Balance Inquiry # 1001\n"
+    "Create Account # USD\n"
+    "Close Account # 1002\n"
+    "1 # 9:30 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 2\n"
+    "Close Account # 1001\n"
+    "Create Account # USD\n"
+    "1 # 19:00 # End of Bank Day\n";
+}  // namespace
+
+using test_support::simulate;
+
+// 销户释放按币种的名额，之后对该账户的操作返回 "Account closed"。
+int main() {
+    const char* path = "close_account_input.txt";
+    test_support::writeFile(path, kInput);
+
+    const auto serial = simulate(path, 1);
+    const auto& out = serial.first;
+    const auto& log = serial.second;
+    // 个人客户 USD 限额为 1：先拒绝，销户后才能再开 / Лимит USD для физлица - 1: сначала отказ, после закрытия можно открыть
+    assert(out.find("1 # 9:0 # Client error. Active account limit reached\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Account closed 1001 # 985.000\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Account closed\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Account Created 1004 # -100.000\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Client error. Access denied\n") != std::string::npos);
+    assert(out.find("1 # 9:30 # Account closed\n") != std::string::npos);
+    assert(out.find("1 # 9:30 # Client error. Active account limit reached\n") != std::string::npos);
+    // 手续费 1.5% 进内部账户，其余以现金付出 / Комиссия 1.5% на внутренний счёт, остальное наличными
+    assert(log.find("1 # 9:0 # 1001 -> 1002 # 15.000\n") != std::string::npos);
+    assert(log.find("1 # 9:0 # 1001 -> # 985.000\n") != std::string::npos);
+    (void)out;
+    (void)log;
+
+    const auto sharded = simulate(path, 3);
+    assert(sharded == serial);
+    std::remove(path);
+    return 0;
+}
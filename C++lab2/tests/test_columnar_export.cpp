@@ -0,0 +1,91 @@
+#include "Bank.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 2\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 1\n"
+    "1002\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 2\n"
+    "Withdraw Funds # 1001 # 100.000\n"
+    "Top-up Founds # 1001 # 50.000\n"
+    "1 # 19:00 # End of Bank Day\n"
+    "2 # 8:00 # Start of Bank Day\n"
+    "2 # 19:00 # End of Bank Day\n";
+}  // namespace
+
+// 每个营业日一个行组；字典列解码为币种/类型名，当天没有过账的账户流量为 0。
+int main() {
+    const char* path = "columnar_input.txt";
+    const char* exportPath = "columnar_export.bin";
+    test_support::writeFile(path, kInput);
+    std::remove(exportPath);
+    test_support::simulate(path, 1, 256, [exportPath](bank::BankSystem& branch) {
+        const bool opened = branch.enableColumnarExport(exportPath);
+        assert(opened);
+        (void)opened;
+    });
+
+    std::vector<bank::ColumnarRowGroup> groups;
+    const bool read = bank::readColumnar(exportPath, groups);
+    assert(read);
+    (void)read;
+    assert(groups.size() == 2);
+    const auto& first = groups[0];
+    assert(first.day == 1 && first.rows == 2 && first.columns.size() == 9);
+    const auto* account = first.column("account");
+    const auto* owner = first.column("owner");
+    const auto* balance = first.column("balance");
+    const auto* currency = first.column("currency");
+    const auto* type = first.column("type");
+    const auto* dayIn = first.column("day_in");
+    const auto* dayOut = first.column("day_out");
+    const auto* postings = first.column("day_postings");
+    assert(account && owner && balance && currency && type && dayIn && dayOut && postings);
+    assert(currency->encoding == bank::ColumnEncoding::Dictionary);
+    assert(account->at<std::uint64_t>(0) == 1001 && account->at<std::uint64_t>(1) == 1002);
+    assert(owner->at<std::uint64_t>(0) == 4001 && owner->at<std::uint64_t>(1) == 0);
+    assert(balance->at<std::int64_t>(0) == 946500);
+    assert(currency->text(0) == "USD" && type->text(1) == "debit");
+    // 1001：取款 100 + 手续费 2.5，充值 50 + 手续费 1 / 1001: снятие 100 + комиссия 2.5, пополнение 50 + комиссия 1
+    assert(dayIn->at<std::int64_t>(0) == 50000 && dayOut->at<std::int64_t>(0) == 103500);
+    assert(postings->at<std::uint32_t>(0) == 4 && postings->at<std::uint32_t>(1) == 2);
+    assert(dayIn->at<std::int64_t>(1) == 3500);
+
+    const auto& second = groups[1];
+    assert(second.day == 2 && second.column("balance")->at<std::int64_t>(0) == 946500);
+    assert(second.column("day_out")->at<std::int64_t>(0) == 0 && second.column("day_postings")->at<std::uint32_t>(0) == 0);
+    (void)account;
+    (void)owner;
+    (void)balance;
+    (void)currency;
+    (void)type;
+    (void)dayIn;
+    (void)dayOut;
+    (void)postings;
+    (void)second;
+
+    std::remove(path);
+    std::remove(exportPath);
+    return 0;
+}
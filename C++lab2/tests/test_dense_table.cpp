@@ -0,0 +1,43 @@
+#include "DenseTable.hpp"
+
+#include <cassert>
+#include <vector>
+
+// DenseTable 按编号直接索引；该测试覆盖向前扩展、离群编号与 emplace 语义。
+int main() {
+    bank::DenseTable<int> table;
+    assert(table.empty());
+    assert(table.find(1001) == nullptr);
+
+    const bool first = table.emplace(1001, 1).second;
+    const bool third = table.emplace(1003, 3).second;
+    const bool again = table.emplace(1001, 100).second;   // 与 unordered_map::emplace 一致，不覆盖
+    assert(first && third && !again);
+    (void)first;
+    (void)third;
+    (void)again;
+    assert(*table.find(1001) == 1);
+    assert(table.find(1002) == nullptr);
+
+    // 编号小于基准：向前扩展 / Номер меньше базы: расширение вперёд
+    const bool below = table.emplace(990, 9).second;
+    assert(below);
+    (void)below;
+    assert(*table.find(990) == 9);
+    assert(*table.find(1003) == 3);
+
+    // 离群编号进入溢出表 / Выброс попадает в переполнение
+    const unsigned long long far = 1'000'000'000'000ULL;
+    const bool outlier = table.emplace(far, 42).second;
+    assert(outlier);
+    (void)outlier;
+    assert(*table.find(far) == 42);
+    assert(table.size() == 4);
+    assert(table.maxId() == far);
+
+    std::vector<unsigned long long> ids;
+    table.forEach([&ids](unsigned long long id, int&) { ids.push_back(id); });
+    assert((ids == std::vector<unsigned long long>{990, 1001, 1003, far}));
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "InterestEngine.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+using bank::AccrualPeriod;
+using bank::InterestEngine;
+
+namespace {
+domain::Deposit deposit(unsigned long long id, double rate, const char* type, unsigned long long created, unsigned long long duration) {
+    domain::Deposit d{};
+    d.id = id;
+    d.rate = rate;
+    d.type = type;
+    d.createdDay = created;
+    d.durationDays = duration;
+    return d;
+}
+}  // namespace
+
+// 计息引擎：类型解析、与 Money::fromDouble 一致的舍入、到期与十万产品的批量计算。
+int main() {
+    const auto daily = bank::parseDepositTerms("Compounded Daily Min ");
+    assert(daily.valid && daily.minimum && daily.period == AccrualPeriod::Daily);
+    (void)daily;
+    assert(bank::parseDepositTerms("Compounded Semi-Annually Remaining").period == AccrualPeriod::SemiAnnual);
+    assert(!bank::parseDepositTerms("Compounded Weekly Remaining").valid);
+    assert(bank::parseLoanTerms("Charged Semi-annually").period == AccrualPeriod::SemiAnnual);
+    assert(!bank::parseLoanTerms("Charged Daily Min").valid);
+
+    InterestEngine engine;
+    engine.addDeposit(1001, deposit(2002, 3.2, "Compounded Daily Min", 1, 2));
+    engine.addDeposit(1000, deposit(2001, 5.5, "Compounded Daily Remaining", 1, 365));
+    engine.addDeposit(1003, deposit(2003, 0.0, "Compounded Daily Remaining", 1, 365));   // 0% 不登记
+    domain::Loan loan{};
+    loan.id = 3001;
+    loan.rate = 12.5;
+    loan.amount = domain::Money::fromUnits(1000000);
+    loan.type = "Charged Daily";
+    engine.addLoan(1002, loan);
+    engine.finalize();
+
+    // 按产品编号排序 / Порядок по номеру продукта
+    auto& deposits = engine.deposits(AccrualPeriod::Daily);
+    assert(deposits.size() == 2 && deposits.productId[0] == 2001 && deposits.account[1] == 1001);
+    deposits.base = {domain::Money::fromUnits(50000).thousandths, domain::Money::fromUnits(20000).thousandths};
+    InterestEngine::computeDeposits(deposits, 1);
+    const auto expected = domain::Money::fromDouble(domain::Money::fromUnits(50000).toDouble() * 5.5 / 100.0 / 365.0);
+    assert(deposits.interest[0] == expected.thousandths && expected.thousandths == 7534);
+    (void)expected;
+    assert(deposits.interest[1] > 0);
+
+    auto& loans = engine.loans(AccrualPeriod::Daily);
+    loans.base = {domain::Money::fromUnits(100000).thousandths};
+    InterestEngine::computeLoans(loans);
+    assert(loans.interest[0] == 308219);
+    loans.base = {domain::Money::fromUnits(1000000).thousandths};  // 未动用的贷款不计息
+    InterestEngine::computeLoans(loans);
+    assert(loans.interest[0] == 0);
+
+    // 2002 在第 3 天到期并被移除，其余顺序不变 / 2002 истекает на 3-й день и удаляется
+    InterestEngine::computeDeposits(deposits, 3);
+    assert(deposits.interest[1] == 0);
+    engine.retireMatured(3);
+    assert(deposits.size() == 1 && deposits.productId[0] == 2001);
+
+    // 十万个存款的一次计算 / Один расчёт по ста тысячам депозитов
+    constexpr std::size_t kProducts = 100'000;
+    InterestEngine large;
+    for (std::size_t i = 0; i < kProducts; ++i) {
+        large.addDeposit(i, deposit(i + 1, 1.0 + static_cast<double>(i % 7), "Compounded Daily Remaining", 1, 0));
+    }
+    large.finalize();
+    auto& book = large.deposits(AccrualPeriod::Daily);
+    for (std::size_t i = 0; i < kProducts; ++i) book.base[i] = static_cast<std::int64_t>(i) * 1000;
+    const auto start = std::chrono::steady_clock::now();
+    InterestEngine::computeDeposits(book, 10);
+    const auto micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    assert(book.interest[0] == 0 && book.interest[kProducts - 1] > 0);
+    std::printf("interest: %zu deposits in %.1f us\n", kProducts, micros);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "Bank.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+using test_support::readAll;
+using test_support::writeFile;
+
+// 运行一次，返回 (响应, 日志)；journal 为空时不写日志 / Запуск, возвращает (ответы, журнал)
+std::pair<std::string, std::string> simulate(const std::filesystem::path& input, const std::string& journal) {
+    return test_support::simulate(input.string(), 1, 256, [&journal](bank::BankSystem& branch) {
+        if (journal.empty()) return;
+        const bool enabled = branch.enableJournal(journal, 2);
+        assert(enabled);
+        (void)enabled;
+    });
+}
+
+// 初始数据取自演示文件，之后是若干营业日的开户、兑换与新客户
+// Начальные данные из демо-файла, затем несколько дней с открытием счетов, обменом и новыми клиентами
+std::string dayEvents(unsigned day) {
+    const auto d = std::to_string(day);
+    return d + " # 8:00 # Start of Bank Day\n" +
+           d + " # 9:30 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 2\n"
+               "Create Account # USD\n"
+               "Currency Exchange # USD -> RUB # 10.0\n" +
+           d + " # 10:00 # Personal Appeal # Client " + d + " # Individual # 1\n"
+               "Create Account # RUB\n" +
+           d + " # 11:00 # Personal Appeal # Petrov Petr Petrovich # VIP Individual Client # 2\n"
+               "Balance Inquiry # 1001\n"
+               "Balance Inquiry # 1005\n" +
+           d + " # 19:00 # End of Bank Day\n";
+}
+}  // namespace
+
+// 分段运行并从快照 + 日志恢复，输出与一次完整运行逐字节一致；日志中不完整的尾部被丢弃。
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s demo_input.txt\n", argv[0]);
+        return 1;
+    }
+    std::string header;
+    {
+        std::FILE* demo = std::fopen(argv[1], "rb");
+        if (!demo) {
+            std::fprintf(stderr, "Failed to open %s\n", argv[1]);
+            return 1;
+        }
+        header = readAll(demo);
+        std::fclose(demo);
+        header.resize(header.find("1 # 8:00 # Start of Bank Day"));
+    }
+
+    const auto dir = std::filesystem::temp_directory_path() / "bank_journal_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::string full = header;
+    std::string firstPart;
+    std::string secondPart;
+    for (unsigned day = 1; day <= 7; ++day) {
+        full += dayEvents(day);
+        if (day == 3) firstPart = full;
+        if (day == 6) secondPart = full;
+    }
+    writeFile((dir / "full.txt").string(), full);
+    writeFile((dir / "part1.txt").string(), firstPart);
+    writeFile((dir / "part2.txt").string(), secondPart);
+
+    const auto expected = simulate(dir / "full.txt", "");
+    const auto journal = (dir / "journal").string();
+    const auto first = simulate(dir / "part1.txt", journal);
+    const auto second = simulate(dir / "part2.txt", journal);
+    {
+        // 模拟写到一半崩溃 / Имитация сбоя посреди записи
+        std::FILE* tail = std::fopen((dir / "journal" / "journal.bin").string().c_str(), "ab");
+        assert(tail);
+        std::fputc(1, tail);
+        std::fclose(tail);
+    }
+    const auto third = simulate(dir / "full.txt", journal);
+
+    assert(first.first + second.first + third.first == expected.first);
+    assert(first.second + second.second + third.second == expected.second);
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "Profiler.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+// LatencyHistogram：桶边界相对误差不超过 1/16，分位数取桶上界且不超过最大值。
+int main() {
+    using bank::LatencyHistogram;
+    for (std::uint64_t value = 0; value < 100000; value += 7) {
+        const auto bucket = LatencyHistogram::bucketOf(value);
+        assert(bucket < LatencyHistogram::kBuckets);
+        const auto upper = LatencyHistogram::upperBound(bucket);
+        assert(upper >= value);
+        assert(upper - value <= value / LatencyHistogram::kSubBuckets);
+        if (bucket > 0) assert(LatencyHistogram::upperBound(bucket - 1) < value);
+        (void)upper;
+    }
+    assert(LatencyHistogram::bucketOf(~std::uint64_t{0}) == LatencyHistogram::kBuckets - 1);
+
+    LatencyHistogram histogram;
+    assert(histogram.percentile(0.5) == 0);
+    for (std::uint64_t value = 1; value <= 1000; ++value) histogram.record(value);
+    assert(histogram.count() == 1000 && histogram.max() == 1000);
+    const auto p50 = histogram.percentile(0.5);
+    assert(p50 >= 500 && p50 <= 500 + 500 / 16);
+    const auto p99 = histogram.percentile(0.99);
+    assert(p99 >= 990 && p99 <= 1000);
+    assert(histogram.percentile(0.999) == 1000);
+
+    LatencyHistogram tail;
+    tail.record(1000000);
+    histogram.merge(tail);
+    assert(histogram.count() == 1001 && histogram.max() == 1000000);
+    assert(histogram.percentile(1.0) == 1000000);
+    assert(histogram.percentile(0.5) == p50);
+
+    (void)p50;
+    (void)p99;
+
+    histogram.clear();
+    assert(histogram.count() == 0 && histogram.max() == 0);
+    return 0;
+}
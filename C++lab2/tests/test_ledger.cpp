@@ -0,0 +1,85 @@
+#include "Bank.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 2\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 1\n"
+    "1002\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 5\n"
+    "Withdraw Funds # 1001 # 100.000\n"
+    "Top-up Founds # 1001 # 50.000\n"
+    "Withdraw Funds # 1001 # 1000.000\n"
+    "Withdraw Funds # 1002 # 1.000\n"
+    "Balance Inquiry # 1001\n"
+    "1 # 19:00 # End of Bank Day\n";
+
+std::pair<std::string, std::string> simulate(const char* input, std::size_t shards, const char* ledger) {
+    return test_support::simulate(input, shards, 256, [ledger](bank::BankSystem& branch) {
+        if (!ledger) return;
+        const bool opened = branch.enableLedger(ledger);
+        assert(opened);
+        (void)opened;
+    });
+}
+}  // namespace
+
+// 取款与充值经账簿过账：交易日志与二进制记录一一对应。
+int main() {
+    const char* path = "ledger_input.txt";
+    const char* ledgerPath = "ledger_records.bin";
+    test_support::writeFile(path, kInput);
+    std::remove(ledgerPath);
+
+    const auto serial = simulate(path, 1, ledgerPath);
+    const auto& out = serial.first;
+    const auto& log = serial.second;
+    // 取款手续费不少于 2.5，充值手续费不少于 1 / Комиссия за снятие не меньше 2.5, за пополнение не меньше 1
+    assert(out.find("1 # 9:0 # Funds Withdrawn 1001 # 897.500\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Fonds Credited 1001 # 946.500\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Client error. Insufficient funds\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Client error. Access denied\n") != std::string::npos);
+    assert(out.find("1 # 9:0 # Balance of 1001 # 946.500\n") != std::string::npos);
+    assert(log == "1 # 9:0 # 1001 -> # 100.000\n"
+                  "1 # 9:0 # 1001 -> 1002 # 2.500\n"
+                  "1 # 9:0 # -> 1001 # 50.000\n"
+                  "1 # 9:0 # 1001 -> 1002 # 1.000\n");
+    (void)out;
+    (void)log;
+
+    std::vector<bank::LedgerRecord> records;
+    const bool read = bank::readLedger(ledgerPath, records);
+    assert(read);
+    (void)read;
+    assert(records.size() == 4);
+    assert(records[0].day == 1 && records[0].minuteOfDay == 9 * 60);
+    assert(records[0].from == 1001 && records[0].to == bank::Ledger::kCash);
+    assert(records[0].amount == domain::Money::fromUnits(100));
+    assert(records[2].from == bank::Ledger::kCash && records[2].to == 1001);
+    assert(records[3].to == 1002 && records[3].amount == domain::Money::fromUnits(1));
+
+    const auto sharded = simulate(path, 3, nullptr);
+    assert(sharded == serial);
+    std::remove(path);
+    std::remove(ledgerPath);
+    return 0;
+}
@@ -2,21 +2,44 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
 
 // 题目对金额处理有严格的四舍五入公式。
-// 该测试验证 Money::round3 与 parseMoneyParts 的边界行为。
+// 该测试验证 Money::round3、Money::fromDouble 与 parseMoneyParts 的边界行为，
+// 以及定点金额的整数格式化。
 int main() {
     using domain::Money;
 
     const double roundedPositive = Money::round3(999999.0004);
     assert(std::abs(roundedPositive - 999999.0) < 1e-9);
+    (void)roundedPositive;
 
     const double roundedNegative = Money::round3(-999999.0005);
     assert(std::abs(roundedNegative + 999999.001) < 1e-9);
+    (void)roundedNegative;
 
-    const double fromParts = domain::parseMoneyParts(1999, 999);
-    assert(std::abs(fromParts - 1999.999) < 1e-9);
+    assert(Money::fromDouble(999999.0004).thousandths == 999999000);
+    assert(Money::fromDouble(-999999.0005).thousandths == -999999001);
+
+    const Money fromParts = domain::parseMoneyParts(1999, 999);
+    assert(fromParts.thousandths == 1999999);
+    (void)fromParts;
+
+    // 定点加减法精确，不需要误差容限。
+    const Money sum = Money::fromThousandths(100) + Money::fromThousandths(200);
+    assert(sum == Money::fromThousandths(300));
+    (void)sum;
+    assert((Money::fromUnits(100) - Money::fromUnits(250)).isNegative());
+
+    char text[domain::kMaxMoneyText]{};
+    *domain::writeMoney(text, -Money::fromUnits(100)) = '\0';
+    assert(std::strcmp(text, "-100.000") == 0);
+    *domain::writeMoney(text, domain::parseMoneyParts(0, 7)) = '\0';
+    assert(std::strcmp(text, "0.007") == 0);
+
+    const auto fmt = domain::formatMoney(Money::fromThousandths(-1234567));
+    assert(fmt.negative && fmt.major == 1234 && fmt.minor == 567);
+    (void)fmt;
 
     return 0;
 }
-
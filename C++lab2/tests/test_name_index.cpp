@@ -0,0 +1,43 @@
+#include "NameIndex.hpp"
+
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+// NameIndex：加载的姓名进入完美哈希，运行时新增的进入溢出表，查找不区分来源。
+int main() {
+    bank::NameIndex index;
+    assert(index.find("Ivanov Ivan Ivanovich") == nullptr);
+
+    std::vector<std::string> names;
+    for (unsigned i = 0; i < 5000; ++i) names.push_back("Client " + std::to_string(i * 7919));
+    std::vector<std::pair<std::string_view, unsigned long long>> entries;
+    for (unsigned long long i = 0; i < names.size(); ++i) entries.emplace_back(names[i], 10000 + i);
+    // 重名保留最后一个编号 / При повторе имени остаётся последний номер
+    entries.emplace_back(names[3], 99);
+    index.build(entries);
+    assert(index.size() == names.size());
+
+    for (unsigned long long i = 0; i < names.size(); ++i) {
+        const auto* id = index.find(names[i]);
+        assert(id && *id == (i == 3 ? 99 : 10000 + i));
+        (void)id;
+    }
+    assert(index.find("Client 1") == nullptr);
+    assert(index.find("") == nullptr);
+    // 前缀不是命中 / Префикс - не совпадение
+    assert(index.find("Client 791") == nullptr);
+
+    // 运行时新增 / Добавление во время работы
+    index.insert("Petrov Petr Petrovich", 20000);
+    assert(*index.find("Petrov Petr Petrovich") == 20000);
+    index.insert(names[0], 30000);
+    assert(*index.find(names[0]) == 30000);
+    assert(index.size() == names.size() + 1);
+
+    index.build({});
+    assert(index.size() == 0);
+    assert(index.find(names[0]) == nullptr);
+    return 0;
+}
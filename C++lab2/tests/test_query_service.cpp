@@ -0,0 +1,122 @@
+#include "Bank.hpp"
+#include "Generator.hpp"
+#include "QueryService.hpp"
+#include "TestSupport.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 2\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 1\n"
+    "1002\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 1\n"
+    "Withdraw Funds # 1001 # 100.000\n"
+    "1 # 19:00 # End of Bank Day\n";
+
+using test_support::ask;
+using test_support::writeFile;
+
+void replay(const char* input, bank::QueryService& service) {
+    test_support::simulate(input, 1, 256, [&service](bank::BankSystem& branch) { branch.attachQueryService(&service); });
+}
+
+/// 通过套接字发送请求并读取 lines 行应答 / Запрос через сокет и чтение lines строк ответа
+std::string exchange(const std::string& path, const std::string& requests, std::size_t lines) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(fd >= 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    const bool connected = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    assert(connected);
+    (void)connected;
+    const auto sent = ::write(fd, requests.data(), requests.size());
+    assert(sent == static_cast<ssize_t>(requests.size()));
+    (void)sent;
+    std::string replies;
+    char chunk[512];
+    while (static_cast<std::size_t>(std::count(replies.begin(), replies.end(), '\n')) < lines) {
+        const auto got = ::read(fd, chunk, sizeof(chunk));
+        if (got <= 0) break;
+        replies.append(chunk, static_cast<std::size_t>(got));
+    }
+    ::close(fd);
+    return replies;
+}
+}  // namespace
+
+// 查询服务按已发布的快照回答；重放进行时并发读取的应答总是完整的一行。
+int main() {
+    const char* inputPath = "query_input.txt";
+    const std::string socketPath = "query_service_test.sock";
+    writeFile(inputPath, kInput);
+
+    bank::QueryService service(2);
+    assert(ask(service, "Balance Inquiry # 1001") == "Not ready\n");
+    replay(inputPath, service);
+    assert(ask(service, "Balance Inquiry # 1001") == "1 # 19:0 # Balance of 1001 # 897.500 # USD\n");
+    assert(ask(service, "Balance Inquiry # 7") == "1 # 19:0 # Client error. Unknown account\n");
+    assert(ask(service, "Client Accounts # 4001") == "1 # 19:0 # Accounts of 4001 # 1001 # 897.500 # USD\n");
+    assert(ask(service, "Day Stats") ==
+           "1 # 19:0 # Day Stats # 1 # 1 # 2 # 0.000 RUB # 0.000 YUAN # 2.500 USD # 0.000 EUR\n");
+    assert(ask(service, "Open Vault") == "Unknown request\n");
+
+    const bool started = service.start(socketPath);
+    assert(started);
+    (void)started;
+    const auto replies = exchange(socketPath, "Balance Inquiry # 1001\nDay Stats\nBalance Inquiry # 1002\n", 3);
+    assert(replies == "1 # 19:0 # Balance of 1001 # 897.500 # USD\n"
+                      "1 # 19:0 # Day Stats # 1 # 1 # 2 # 0.000 RUB # 0.000 YUAN # 2.500 USD # 0.000 EUR\n"
+                      "1 # 19:0 # Balance of 1002 # 500002.500 # USD\n");
+
+    // 写线程重放时读者并发查询 / Читатели запрашивают параллельно с воспроизведением
+    bank::GeneratorConfig config;
+    config.clients = 2000;
+    config.days = 5;
+    config.appealsPerDay = 200;
+    writeFile(inputPath, bank::generateBranchInput(config).text);
+    std::atomic<bool> replaying{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (replaying.load()) {
+                const auto reply = exchange(socketPath, "Balance Inquiry # 1000\nDay Stats\n", 2);
+                assert(reply.size() > 2 && reply.back() == '\n');
+            }
+        });
+    }
+    service.setPublishInterval(std::chrono::milliseconds(1));
+    replay(inputPath, service);
+    replaying = false;
+    for (auto& reader : readers) reader.join();
+    assert(service.snapshot()->time.day == 5);
+    service.stop();
+    std::remove(inputPath);
+    return 0;
+}
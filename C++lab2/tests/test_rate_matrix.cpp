@@ -0,0 +1,43 @@
+#include "Domain.hpp"
+
+#include <cassert>
+#include <cmath>
+
+using domain::Currency;
+
+namespace {
+[[maybe_unused]] double rate(const domain::RateMatrix& rates, Currency from, Currency to) {
+    return rates[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)];
+}
+
+[[maybe_unused]] bool near(double a, double b) { return std::fabs(a - b) < 1e-9 * std::fabs(b); }
+}  // namespace
+
+// 汇率矩阵：直接报价、反向报价的倒数、经中间货币的交叉汇率与无法兑换的币种对。
+int main() {
+    const std::vector<domain::ExchangeRate> quotes = {
+        {Currency::USD, Currency::RUB, 75.5},
+        {Currency::EUR, Currency::RUB, 85.2},
+        {Currency::RUB, Currency::USD, 0.0132},  // 直接报价优先于倒数 / Прямая котировка важнее обратной
+    };
+    const auto rates = domain::buildRateMatrix(quotes);
+
+    assert(rate(rates, Currency::RUB, Currency::RUB) == 1.0);
+    assert(rate(rates, Currency::USD, Currency::RUB) == 75.5);
+    assert(rate(rates, Currency::RUB, Currency::USD) == 0.0132);
+    assert(near(rate(rates, Currency::RUB, Currency::EUR), 1.0 / 85.2));
+    assert(near(rate(rates, Currency::EUR, Currency::USD), 85.2 * 0.0132));
+    assert(near(rate(rates, Currency::USD, Currency::EUR), 75.5 / 85.2));
+    (void)rates;
+
+    // 没有任何报价的货币无法兑换 / Валюта без котировок не обменивается
+    assert(rate(rates, Currency::YUAN, Currency::RUB) == 0.0);
+    assert(rate(rates, Currency::EUR, Currency::YUAN) == 0.0);
+    assert(rate(rates, Currency::YUAN, Currency::YUAN) == 1.0);
+
+    // 未知货币与非正系数被忽略 / Неизвестные валюты и неположительные курсы игнорируются
+    const auto empty = domain::buildRateMatrix({{Currency::Unknown, Currency::RUB, 2.0}, {Currency::USD, Currency::EUR, 0.0}});
+    assert(rate(empty, Currency::USD, Currency::EUR) == 0.0);
+    (void)empty;
+    return 0;
+}
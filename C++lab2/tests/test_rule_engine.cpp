@@ -0,0 +1,100 @@
+#include "Bank.hpp"
+#include "RuleEngine.hpp"
+#include "TestSupport.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr const char* kInput =
+    "Accounts 2\n"
+    "1001 # debit # 1000.000 # USD\n"
+    "1002 # debit # 500000.000 # USD\n"
+    "Debits 0\n"
+    "Credits 0\n"
+    "Clients 1\n"
+    "4001 # Ivanov Ivan Ivanovich # Individual Client\n"
+    "Client Debit 1\n"
+    "4001 # 1001 # 0\n"
+    "Bank Accounts 1\n"
+    "1002\n"
+    "Client Credit 0\n"
+    "Work Places 2\n"
+    "Client Manager # 1\n"
+    "Cash Desk # 1\n"
+    "Exchange Rates 0\n"
+    "1 # 8:00 # Start of Bank Day\n"
+    "1 # 9:00 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 1\n"
+    "Withdraw Funds # 1001 # 100.000\n"
+    "1 # 11:30 # Personal Appeal # Ivanov Ivan Ivanovich # Individual # 1\n"
+    "Top-up Founds # 1001 # 50.000\n"
+    "1 # 19:00 # End of Bank Day\n";
+
+domain::Money money(std::int64_t thousandths) { return domain::Money::fromThousandths(thousandths); }
+}  // namespace
+
+// 滑动窗口计数、大额阈值与规则文件错误；重放时按过账发起方触发。
+int main() {
+    bank::RuleEngine engine;
+    assert(!engine.parse("Velocity # 0 # 60\n"));
+    assert(!engine.parse("Large Transfer # 100.000 # GBP\n"));
+    assert(!engine.parse("Unknown Rule # 1 # 1\n"));
+    const bool parsed = engine.parse("Velocity # 2 # 60\n\nLarge Transfer # 1000 # USD\nAccounts Opened # 1 # 1440\n");
+    assert(parsed);
+    (void)parsed;
+    assert(engine.rules() == 3);
+
+    // 第三笔落在 60 分钟内才超限 / Предел превышен только третьей проводкой за 60 минут
+    auto alerts = engine.onPosting({1, 9, 0}, 4001, 1001, domain::Currency::USD, money(1000));
+    assert(alerts.empty());
+    alerts = engine.onPosting({1, 9, 30}, 4001, 1001, domain::Currency::USD, money(1000));
+    assert(alerts.empty());
+    alerts = engine.onPosting({1, 9, 59}, 4001, 1001, domain::Currency::USD, money(1000));
+    assert(alerts.size() == 1 && alerts[0].rule == 1 && alerts[0].kind == bank::RuleKind::Velocity);
+    // 9:30 已滑出窗口 / 9:30 уже вне окна
+    alerts = engine.onPosting({1, 10, 31}, 4001, 1001, domain::Currency::USD, money(1000));
+    assert(alerts.empty());
+    // 其他客户有自己的窗口 / У другого клиента своё окно
+    alerts = engine.onPosting({1, 10, 0}, 4002, 1003, domain::Currency::USD, money(1000));
+    assert(alerts.empty());
+
+    alerts = engine.onPosting({2, 9, 0}, 4001, 1001, domain::Currency::USD, money(1000000));
+    assert(alerts.size() == 1 && alerts[0].rule == 2 && alerts[0].amount == money(1000000));
+    alerts = engine.onPosting({3, 9, 0}, 4001, 1001, domain::Currency::EUR, money(5000000));
+    assert(alerts.empty());
+
+    alerts = engine.onAccountOpened({1, 9, 0}, 4001, 1010);
+    assert(alerts.empty());
+    alerts = engine.onAccountOpened({1, 18, 0}, 4001, 1011);
+    assert(alerts.size() == 1 && alerts[0].kind == bank::RuleKind::AccountsOpened && alerts[0].accountId == 1011);
+    alerts = engine.onAccountOpened({2, 18, 1}, 4001, 1012);
+    assert(alerts.empty());
+
+    const char* inputPath = "rule_engine_input.txt";
+    const char* rulesPath = "rule_engine_rules.txt";
+    test_support::writeFile(inputPath, kInput);
+    test_support::writeFile(rulesPath, "Large Transfer # 100.000 # USD\nVelocity # 1 # 60\n");
+
+    std::FILE* alertsFile = std::tmpfile();
+    assert(alertsFile);
+    test_support::simulate(inputPath, 1, 256, [rulesPath, alertsFile](bank::BankSystem& branch) {
+        const bool missing = branch.enableRules("rule_engine_missing.txt", alertsFile);
+        assert(!missing);
+        const bool enabled = branch.enableRules(rulesPath, alertsFile);
+        assert(enabled);
+        (void)missing;
+        (void)enabled;
+    });
+    std::remove(inputPath);
+    std::remove(rulesPath);
+
+    // 手续费是同一分钟内的第二笔过账 / Комиссия - вторая проводка клиента в ту же минуту
+    const auto report = test_support::readAll(alertsFile);
+    assert(report ==
+           "1 # 9:0 # Alert # 1 # Large Transfer # 4001 # 1001 # 100.000\n"
+           "1 # 9:0 # Alert # 2 # Velocity # 4001 # 1001 # 2.500\n"
+           "1 # 11:30 # Alert # 2 # Velocity # 4001 # 1001 # 1.000\n");
+    std::fclose(alertsFile);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Scheduler.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+using domain::WorkplaceKind;
+
+namespace {
+std::vector<domain::WorkplaceDefinition> desks(unsigned long long managers, unsigned long long cash) {
+    std::vector<domain::WorkplaceDefinition> defs(2);
+    defs[0].type = WorkplaceKind::ClientManager;
+    defs[0].count = managers;
+    defs[1].type = WorkplaceKind::CashDesk;
+    defs[1].count = cash;
+    return defs;
+}
+}  // namespace
+
+// 排队调度：VIP 优先、多岗位阶段、营业结束与大量客户的推进。
+int main() {
+    bank::WorkplaceScheduler scheduler;
+    scheduler.configure(desks(1, 1));
+
+    // 一个经理：普通客户先到，VIP 在其办理时到达并插到等候的普通客户之前
+    // Один менеджер: VIP, пришедший во время обслуживания, обходит ожидающего обычного
+    scheduler.startDay();
+    scheduler.addCustomer(9 * 60, false);
+    scheduler.addService(WorkplaceKind::ClientManager, 10);
+    scheduler.addCustomer(9 * 60 + 1, false);
+    scheduler.addService(WorkplaceKind::ClientManager, 10);
+    scheduler.addCustomer(9 * 60 + 2, true);
+    scheduler.addService(WorkplaceKind::VipManager, 10);   // 无 VIP 经理时由普通经理接待
+    scheduler.addService(WorkplaceKind::CashDesk, 5);
+    auto report = scheduler.finishDay();
+    assert(report.customers == 3 && report.turnedAway == 0);
+    assert(report.served[static_cast<std::size_t>(WorkplaceKind::ClientManager)][0] == 3);
+    assert(report.served[static_cast<std::size_t>(WorkplaceKind::CashDesk)][0] == 1);
+    // 等待：0、VIP 8、普通 19 分钟 / Ожидание: 0, VIP 8, обычный 19 минут
+    assert(report.waitHistogram.size() == 20);
+    assert(report.waitHistogram[0] == 1 && report.waitHistogram[8] == 1 && report.waitHistogram[19] == 1);
+    assert(bank::waitPercentile(report.waitHistogram, 0.5) == 8);
+    assert(bank::waitPercentile(report.waitHistogram, 0.99) == 19);
+
+    // 营业前到达按开门计，营业结束后到达不受理 / До открытия - с 8:00, после закрытия - не обслуживаются
+    scheduler.startDay();
+    scheduler.addCustomer(7 * 60, false);
+    scheduler.addService(WorkplaceKind::CashDesk, 5);
+    scheduler.addCustomer(19 * 60, false);
+    scheduler.addService(WorkplaceKind::CashDesk, 5);
+    scheduler.addCustomer(10 * 60, false);
+    scheduler.addService(WorkplaceKind::CurrencyExchange, 10);  // 分行没有该岗位
+    report = scheduler.finishDay();
+    assert(report.customers == 2 && report.turnedAway == 1);
+    assert(report.waitHistogram.size() == 1 && report.waitHistogram[0] == 1);
+
+    // 大量客户：一天内到达一百万人，队伍在营业结束时截断
+    // Миллион клиентов за день: очередь обрывается закрытием
+    constexpr std::uint32_t kCustomers = 1'000'000;
+    scheduler.configure(desks(50, 200));
+    scheduler.startDay();
+    for (std::uint32_t i = 0; i < kCustomers; ++i) {
+        scheduler.addCustomer(8 * 60 + i % (11 * 60), i % 10 == 0);
+        if (i % 3 == 0) scheduler.addService(WorkplaceKind::ClientManager, 10);
+        scheduler.addService(WorkplaceKind::CashDesk, 5);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    report = scheduler.finishDay();
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    unsigned long long finished = 0;
+    for (auto count : report.waitHistogram) finished += count;
+    assert(report.customers == kCustomers);
+    assert(finished + report.turnedAway == kCustomers);
+    unsigned long long cashServed = 0;
+    for (auto count : report.served[static_cast<std::size_t>(WorkplaceKind::CashDesk)]) cashServed += count;
+    // 每个窗口每 5 分钟一人 / Одна касса - клиент за 5 минут
+    assert(cashServed <= 200ull * (11 * 60 / 5));
+    std::printf("scheduler: %u customers in %.3f s\n", kCustomers, seconds);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cassert>
+
+// 线程池：外部提交、任务内嵌套提交与 wait() 覆盖全部子任务。
+int main() {
+    std::atomic<int> counter{0};
+    {
+        bank::ThreadPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&counter] { counter.fetch_add(1); });
+        }
+        pool.wait();
+        assert(counter.load() == 1000);
+
+        // 子任务进入当前线程队列，可被其他线程窃取 / Подзадачи в своей очереди, доступны для перехвата
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([&pool, &counter] {
+                for (int j = 0; j < 100; ++j) pool.submit([&counter] { counter.fetch_add(1); });
+            });
+        }
+        pool.wait();
+        assert(counter.load() == 2000);
+
+        pool.submit([&counter] { counter.fetch_add(1); });
+    }   // 析构时等待剩余任务 / Деструктор дожидается оставшихся задач
+    assert(counter.load() == 2001);
+    return 0;
+}
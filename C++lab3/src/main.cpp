@@ -1,6 +1,7 @@
 #include "regex_engine.hpp"
 
 #include <iostream>
+#include <optional>
 #include <string>
 
 // 协议 / Протокол:
@@ -20,16 +21,25 @@ int main() {
         return 0;
     }
 
+    // 模式只编译一次；非法模式对每一行都输出 false。
+    // Шаблон компилируется один раз; при некорректном шаблоне для каждой строки выводится false.
+    std::optional<regex_engine::Regex> re;
+    try {
+        re = regex_engine::compile(pattern);
+    } catch (const std::exception&) {
+        // 保持为空 / остаётся пустым
+    }
+
     std::string line;
     while (std::getline(std::cin, line)) {
         bool ok = false;
         try {
-            // 使用我们的引擎检查整串是否匹配模式。
-            // Используем движок, чтобы проверить полное совпадение строки с шаблоном.
-            ok = regex_engine::full_match(pattern, line);
+            // 使用编译好的正则检查整串是否匹配模式。
+            // Используем скомпилированное выражение, чтобы проверить полное совпадение строки с шаблоном.
+            ok = re && re->full_match(line);
         } catch (const std::exception&) {
-            // 如果模式非法或匹配过程中抛出异常，则统一视为 false。
-            // Если шаблон некорректен или произошла ошибка — считаем результат ложным.
+            // 如果匹配过程中抛出异常，则统一视为 false。
+            // Если при сопоставлении произошла ошибка — считаем результат ложным.
             ok = false;
         }
         std::cout << (ok ? "true" : "false") << '\n';
@@ -1,6 +1,7 @@
 #include "regex_engine.hpp"
 
 #include <stdexcept> 
+#include <utility>
 
 namespace regex_engine {
 
@@ -239,20 +240,14 @@ NodePtr Parser::parseAtom() {
     return std::make_shared<Atom>(Atom::Kind::Literal, c, q);
 }
 
-// ===== Public API =====
-// 公共接口：从模式字符串构造 AST。
-// Публичный интерфейс: построить AST из строки шаблона.
-NodePtr compile(const std::string& pattern) {
-    Parser p(pattern);
-    return p.parse();
-}
+// ===== Regex =====
+Regex::Regex(NodePtr root) : root_(std::move(root)) {}
 
-bool full_match(const std::string& pattern, const std::string& text) {
-    // 先编译模式，再从位置 0 开始整串匹配。
-    // Сначала компилируем шаблон, затем пытаемся сопоставить строку с нуля.
-    NodePtr root = compile(pattern);
+bool Regex::full_match(const std::string& text) const {
+    // 从位置 0 开始整串匹配。
+    // Пытаемся сопоставить строку с нуля.
     std::size_t pos = 0;
-    if (!root->match(text, 0, pos)) {
+    if (!root_->match(text, 0, pos)) {
         return false;
     }
     // 只有当消费到字符串末尾才算“完全匹配”。
@@ -260,4 +255,16 @@ bool full_match(const std::string& pattern, const std::string& text) {
     return pos == text.size();
 }
 
+// ===== Public API =====
+// 公共接口：从模式字符串构造 AST。
+// Публичный интерфейс: построить AST из строки шаблона.
+Regex compile(const std::string& pattern) {
+    Parser p(pattern);
+    return Regex(p.parse());
+}
+
+bool full_match(const std::string& pattern, const std::string& text) {
+    return compile(pattern).full_match(text);
+}
+
 }
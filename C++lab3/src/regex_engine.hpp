@@ -113,11 +113,31 @@ private:
     std::vector<Atom::CharClassRange> parseCharClass();
 };
 
-// 公共 API：编译模式字符串。
-// Публичный API: компиляция шаблона.
-NodePtr compile(const std::string& pattern);
-// 公共 API：检查 text 是否“整体匹配”模式。
-// Публичный API: проверить, полностью ли строка text соответствует шаблону.
+// 编译好的正则：模式只解析一次，之后可对任意多的字符串重复匹配。
+// Скомпилированное выражение: шаблон разбирается один раз, затем
+// сопоставляется с любым количеством строк.
+class Regex {
+public:
+    explicit Regex(NodePtr root);
+
+    // 检查 text 是否“整体匹配”模式。
+    // Проверить, полностью ли строка text соответствует шаблону.
+    bool full_match(const std::string& text) const;
+
+    // 编译得到的 AST 根节点。
+    // Корень скомпилированного AST.
+    const NodePtr& root() const { return root_; }
+
+private:
+    NodePtr root_;
+};
+
+// 公共 API：编译模式字符串。若模式非法，抛出 std::runtime_error。
+// Публичный API: компиляция шаблона. При ошибке бросает std::runtime_error.
+Regex compile(const std::string& pattern);
+// 公共 API：一次性检查 text 是否“整体匹配”模式（每次调用都重新编译）。
+// Публичный API: разовая проверка полного совпадения text с шаблоном
+// (шаблон компилируется при каждом вызове).
 bool full_match(const std::string& pattern, const std::string& text);
 
 }
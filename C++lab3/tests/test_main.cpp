@@ -67,6 +67,33 @@ int main() {
         }
     }
 
+    // 编译一次、匹配多次：匹配与不匹配交替，结果不受前一次匹配影响。
+    // Одна компиляция, много сопоставлений: совпадения чередуются с несовпадениями,
+    // и результат не зависит от предыдущего сопоставления.
+    const regex_engine::Regex re = regex_engine::compile("a.[b-d]+c?");
+    const struct {
+        std::string text;
+        bool expected;
+    } compiledCases[] = {
+        {"axbcc", true},
+        {"ax", false},
+        {"axb", true},
+        {"bxb", false},
+        {"axbccc", true},
+        {"axe", false},
+        {"axbcc", true},
+    };
+    for (const auto& c : compiledCases) {
+        ++total;
+        const bool got = re.full_match(c.text);
+        if (got != c.expected) {
+            ++failed;
+            std::cerr << "FAIL compiled pattern text='" << c.text
+                      << "' expected=" << (c.expected ? "true" : "false")
+                      << " got=" << (got ? "true" : "false") << '\n';
+        }
+    }
+
     if (failed == 0) {
         std::cout << "All " << total << " tests passed.\n";
         return 0;